@@ -1,9 +1,20 @@
 #include <QApplication>
+#include <QCommandLineParser>
+#include <QSurfaceFormat>
 #include "ui/MainWindow.h"
 #include "ui/StyleLoader.h"
+#include "src/data/Database.h"
+#include "src/data/DataTransfer.h"
 
 int main(int argc, char *argv[])
 {
+    // 棋盘使用着色器 + 实例化绘制，需要 OpenGL 3.3
+    QSurfaceFormat format;
+    format.setVersion(3, 3);
+    format.setProfile(QSurfaceFormat::CoreProfile);
+    format.setSwapInterval(1);  // 垂直同步：GameView 的帧循环以 frameSwapped 为节拍
+    QSurfaceFormat::setDefaultFormat(format);
+    
     QApplication app(argc, argv);
     
     // 设置应用程序信息
@@ -11,6 +22,28 @@ int main(int argc, char *argv[])
     QApplication::setApplicationVersion("1.0.0");
     QApplication::setOrganizationName("GameDev");
     
+    // 命令行数据导出/导入（不启动界面）
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    parser.addVersionOption();
+    QCommandLineOption exportOption("export-data", "Export player data to an NDJSON file.", "file");
+    QCommandLineOption importOption("import-data", "Import player data from an NDJSON file.", "file");
+    parser.addOption(exportOption);
+    parser.addOption(importOption);
+    parser.process(app);
+    
+    if (parser.isSet(exportOption) || parser.isSet(importOption)) {
+        QString dbPath = QCoreApplication::applicationDirPath() + "/fruitcrush.db";
+        if (!Database::instance().initialize(dbPath)) {
+            return 1;
+        }
+        bool ok = parser.isSet(exportOption)
+            ? DataTransfer::exportToFile(parser.value(exportOption))
+            : DataTransfer::importFromFile(parser.value(importOption));
+        Database::instance().close();
+        return ok ? 0 : 1;
+    }
+    
     // 加载奶油风格样式表
     StyleLoader::applyStyles();
     
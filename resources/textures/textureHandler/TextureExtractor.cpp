@@ -1,6 +1,11 @@
 #include "TextureExtractor.h"
 #include <QDir>
 #include <QFileInfo>
+#include <QFile>
+#include <QPainter>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
 #include <algorithm>
 #include <cmath>
 
@@ -207,3 +212,128 @@ QImage TextureExtractor::extractCenteredRegion(const QImage& source, const QPoin
     
     return result;
 }
+
+bool TextureExtractor::packAtlas(const QStringList& names, const std::vector<QImage>& images,
+                                 int cellSize, int padding) {
+    if (names.size() != static_cast<int>(images.size()) || images.empty() || cellSize <= 0) {
+        return false;
+    }
+    
+    atlasSprites_.clear();
+    
+    // 近似正方形的网格布局
+    int count = static_cast<int>(images.size());
+    int columns = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(count))));
+    int rows = (count + columns - 1) / columns;
+    int stride = cellSize + padding * 2;
+    
+    atlasImage_ = QImage(columns * stride, rows * stride, QImage::Format_RGBA8888);
+    atlasImage_.fill(Qt::transparent);
+    
+    QPainter painter(&atlasImage_);
+    painter.setRenderHint(QPainter::SmoothPixmapTransform);
+    
+    for (int i = 0; i < count; ++i) {
+        QRect cell((i % columns) * stride + padding, (i / columns) * stride + padding, cellSize, cellSize);
+        
+        // 保持比例缩放并在格内居中
+        if (!images[i].isNull()) {
+            QImage scaled = images[i].scaled(cellSize, cellSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+            painter.drawImage(cell.x() + (cellSize - scaled.width()) / 2,
+                              cell.y() + (cellSize - scaled.height()) / 2, scaled);
+        }
+        
+        AtlasSprite sprite;
+        sprite.name = names[i];
+        sprite.rect = cell;
+        sprite.uv = QRectF(static_cast<double>(cell.x()) / atlasImage_.width(),
+                           static_cast<double>(cell.y()) / atlasImage_.height(),
+                           static_cast<double>(cell.width()) / atlasImage_.width(),
+                           static_cast<double>(cell.height()) / atlasImage_.height());
+        atlasSprites_.push_back(sprite);
+    }
+    
+    painter.end();
+    return true;
+}
+
+bool TextureExtractor::saveAtlas(const QString& imagePath, const QString& metaPath) const {
+    if (atlasImage_.isNull()) {
+        return false;
+    }
+    
+    QDir().mkpath(QFileInfo(imagePath).absolutePath());
+    if (!atlasImage_.save(imagePath)) {
+        return false;
+    }
+    
+    // 元数据：像素区域 + 归一化 UV
+    QJsonArray sprites;
+    for (const auto& sprite : atlasSprites_) {
+        QJsonObject item;
+        item["name"] = sprite.name;
+        item["rect"] = QJsonArray{ sprite.rect.x(), sprite.rect.y(), sprite.rect.width(), sprite.rect.height() };
+        item["uv"] = QJsonArray{ sprite.uv.left(), sprite.uv.top(), sprite.uv.right(), sprite.uv.bottom() };
+        sprites.append(item);
+    }
+    
+    QJsonObject root;
+    root["image"] = QFileInfo(imagePath).fileName();
+    root["width"] = atlasImage_.width();
+    root["height"] = atlasImage_.height();
+    root["sprites"] = sprites;
+    
+    QFile file(metaPath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    file.write(QJsonDocument(root).toJson());
+    return true;
+}
+
+bool TextureExtractor::loadAtlas(const QString& imagePath, const QString& metaPath) {
+    QFile file(metaPath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    
+    QImage image(imagePath);
+    if (image.isNull()) {
+        return false;
+    }
+    
+    QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+    if (root["width"].toInt() != image.width() || root["height"].toInt() != image.height()) {
+        return false;  // 元数据与图像不匹配（图集被单独替换过）
+    }
+    
+    std::vector<AtlasSprite> sprites;
+    for (const auto& value : root["sprites"].toArray()) {
+        QJsonObject item = value.toObject();
+        QJsonArray rect = item["rect"].toArray();
+        QJsonArray uv = item["uv"].toArray();
+        if (rect.size() != 4 || uv.size() != 4) {
+            return false;
+        }
+        
+        AtlasSprite sprite;
+        sprite.name = item["name"].toString();
+        sprite.rect = QRect(rect[0].toInt(), rect[1].toInt(), rect[2].toInt(), rect[3].toInt());
+        sprite.uv = QRectF(QPointF(uv[0].toDouble(), uv[1].toDouble()),
+                           QPointF(uv[2].toDouble(), uv[3].toDouble()));
+        sprites.push_back(sprite);
+    }
+    
+    atlasImage_ = image.convertToFormat(QImage::Format_RGBA8888);
+    atlasSprites_ = sprites;
+    return true;
+}
+
+const TextureExtractor::AtlasSprite* TextureExtractor::findSprite(const QString& name) const {
+    for (const auto& sprite : atlasSprites_) {
+        if (sprite.name == name) {
+            return &sprite;
+        }
+    }
+    return nullptr;
+}
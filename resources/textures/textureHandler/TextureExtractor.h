@@ -3,7 +3,9 @@
 
 #include <QImage>
 #include <QString>
+#include <QStringList>
 #include <QRect>
+#include <QRectF>
 #include <QPoint>
 #include <vector>
 
@@ -15,6 +17,7 @@
  * - 自动检测每个元素的边界框
  * - 计算元素中心点
  * - 提取并保存独立材质
+ * - 把多张材质打包为一张图集（atlas），并输出 UV 元数据（JSON）
  */
 class TextureExtractor {
 public:
@@ -28,6 +31,15 @@ public:
         int gridCol;            // 网格列（0-3）
     };
 
+    /**
+     * @brief 图集中的单个精灵
+     */
+    struct AtlasSprite {
+        QString name;           // 精灵名称（如 "apple"）
+        QRect rect;             // 图集中的像素区域
+        QRectF uv;              // 归一化纹理坐标（左上 → 右下）
+    };
+
     /**
      * @brief 构造函数
      */
@@ -79,6 +91,47 @@ public:
      */
     const std::vector<QImage>& getTextures() const { return textures_; }
 
+    /**
+     * @brief 把多张图像打包为一张图集（等大网格，保持比例居中缩放）
+     * @param names 精灵名称（与 images 一一对应）
+     * @param images 源图像
+     * @param cellSize 每个精灵的像素边长（默认160）
+     * @param padding 精灵之间的透明间隔，避免线性过滤串色（默认2）
+     * @return 是否打包成功
+     */
+    bool packAtlas(const QStringList& names, const std::vector<QImage>& images,
+                   int cellSize = 160, int padding = 2);
+
+    /**
+     * @brief 保存图集图像与 UV 元数据
+     * @param imagePath 图集 PNG 路径
+     * @param metaPath 元数据 JSON 路径
+     * @return 是否保存成功
+     */
+    bool saveAtlas(const QString& imagePath, const QString& metaPath) const;
+
+    /**
+     * @brief 加载之前保存的图集与 UV 元数据
+     * @return 是否加载成功
+     */
+    bool loadAtlas(const QString& imagePath, const QString& metaPath);
+
+    /**
+     * @brief 获取图集图像
+     */
+    const QImage& getAtlasImage() const { return atlasImage_; }
+
+    /**
+     * @brief 获取图集精灵列表
+     */
+    const std::vector<AtlasSprite>& getAtlasSprites() const { return atlasSprites_; }
+
+    /**
+     * @brief 按名称查找图集精灵
+     * @return 精灵指针，不存在时返回 nullptr
+     */
+    const AtlasSprite* findSprite(const QString& name) const;
+
 private:
     /**
      * @brief 检测单个网格单元的边界框
@@ -114,6 +167,8 @@ private:
     std::vector<ElementInfo> elements_;     // 元素信息列表
     std::vector<QImage> textures_;          // 提取的材质列表
     QSize unifiedSize_;                     // 统一尺寸
+    QImage atlasImage_;                     // 图集图像
+    std::vector<AtlasSprite> atlasSprites_; // 图集精灵列表
     int rows_;                              // 网格行数
     int cols_;                              // 网格列数
 };
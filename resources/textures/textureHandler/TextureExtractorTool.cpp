@@ -8,10 +8,58 @@
  * 使用方法：
  * 1. 直接运行：提取到默认输出目录 resources/textures/
  * 2. 命令行参数：TextureExtractorTool <输入图片> <输出目录> <前缀>
+ * 3. 打包图集：TextureExtractorTool --atlas <图集PNG> <元数据JSON> <名称=图片路径>...
+ *    例：--atlas resources/textures/fruit_atlas.png resources/textures/fruit_atlas.json
+ *        apple=resources/textures/apple.png hammer=resources/props/hammer.png ...
  */
+static int packAtlas(int argc, char *argv[]) {
+    if (argc < 5) {
+        qDebug() << "用法: TextureExtractorTool --atlas <图集PNG> <元数据JSON> <名称=图片路径>...";
+        return 1;
+    }
+    
+    QString atlasPath = argv[2];
+    QString metaPath = argv[3];
+    
+    QStringList names;
+    std::vector<QImage> images;
+    for (int i = 4; i < argc; ++i) {
+        QString entry = argv[i];
+        int split = entry.indexOf('=');
+        if (split <= 0) {
+            qDebug() << "错误: 参数格式应为 名称=图片路径:" << entry;
+            return 1;
+        }
+        
+        QImage image(entry.mid(split + 1));
+        if (image.isNull()) {
+            qDebug() << "错误: 无法加载图像" << entry.mid(split + 1);
+            return 1;
+        }
+        names.append(entry.left(split));
+        images.push_back(image);
+    }
+    
+    TextureExtractor extractor;
+    if (!extractor.packAtlas(names, images) || !extractor.saveAtlas(atlasPath, metaPath)) {
+        qDebug() << "错误: 图集打包失败";
+        return 1;
+    }
+    
+    QSize size = extractor.getAtlasImage().size();
+    qDebug() << QString("✓ 图集 %1x%2，共 %3 个精灵").arg(size.width()).arg(size.height()).arg(names.size());
+    qDebug() << "图集:" << atlasPath;
+    qDebug() << "元数据:" << metaPath;
+    return 0;
+}
+
 int main(int argc, char *argv[]) {
     QCoreApplication app(argc, argv);
     
+    if (argc > 1 && QString(argv[1]) == "--atlas") {
+        return packAtlas(argc, argv);
+    }
+    
     // 默认参数
     QString inputPath = "D:/codeproject/DataSructure/06-General/Game_Qoder_2/resources/texture.png";
     QString outputDir = "resources/textures";
@@ -6,6 +6,7 @@
 #include <QDebug>
 #include <QDateTime>
 #include <QSet>
+#include <QTimer>
 
 // ==================== AchievementManager 实现 ====================
 
@@ -18,6 +19,7 @@ AchievementManager& AchievementManager::instance()
 AchievementManager::AchievementManager()
     : workerThread_(nullptr)
     , worker_(nullptr)
+    , gameEngine_(nullptr)
 {
 }
 
@@ -36,7 +38,7 @@ void AchievementManager::initialize()
     
     // 2. 创建工作线程
     workerThread_ = new QThread();
-    worker_ = new AchievementWorker(&achievements_);
+    worker_ = new AchievementWorker(&achievements_, &eventRing_, &drainScheduled_);
     worker_->moveToThread(workerThread_);
     
     // 3. 连接信号
@@ -46,6 +48,8 @@ void AchievementManager::initialize()
             worker_, &AchievementWorker::onGameStarted);
     connect(this, &AchievementManager::gameEnded,
             worker_, &AchievementWorker::onGameEnded);
+    connect(this, &AchievementManager::eventsPending,
+            worker_, &AchievementWorker::drainEvents);
     connect(worker_, &AchievementWorker::achievementUnlocked,
             this, &AchievementManager::handleAchievementUnlocked);
     
@@ -73,6 +77,14 @@ void AchievementManager::shutdown()
  */
 void AchievementManager::setGameEngine(GameEngine* engine)
 {
+    // 切换引擎时转移事件订阅
+    if (gameEngine_) {
+        gameEngine_->getEventBus().unsubscribe(this);
+    }
+    if (engine) {
+        engine->getEventBus().subscribe(this);
+    }
+    
     gameEngine_ = engine;
     if (worker_) {
         worker_->setGameEngine(engine);
@@ -289,18 +301,81 @@ void AchievementManager::onPropUsed(const QString& propType, int chainEliminate)
     emit gameDataReceived(currentGameData_);
 }
 
+/**
+ * @brief 处理引擎事件
+ * 
+ * 把匹配组、特殊元素生成/引爆、道具使用转换为定长成就事件写入无锁队列，
+ * 每批事件最多投递一次唤醒信号，工作线程批量取出检测
+ */
+void AchievementManager::onGameEvents(const GameEvent* events, int count)
+{
+    if (!worker_) {
+        return;
+    }
+    
+    // 引擎自身先于成就系统订阅，此时会话统计已包含本批事件
+    AchievementEvent base = {};
+    if (gameEngine_) {
+        base.currentScore = gameEngine_->getCurrentScore();
+        base.eliminateCount = gameEngine_->getSessionStats().totalEliminates;
+        base.propUsed = gameEngine_->getSessionStats().propUsed > 0;
+    }
+    
+    bool pushed = false;
+    for (int i = 0; i < count; ++i) {
+        const GameEvent& event = events[i];
+        
+        AchievementEvent item = base;
+        item.kind = event.type;
+        switch (event.type) {
+            case GameEventType::MATCH_FORMED:
+                item.matchSize = event.match.count;
+                item.matchElementType = event.match.fruitType;
+                item.combo = event.match.combo;
+                break;
+            case GameEventType::SPECIAL_CREATED:
+            case GameEventType::SPECIAL_TRIGGERED:
+                if (event.special.special == 0 || event.special.special > 4) {
+                    continue;
+                }
+                item.special = event.special.special;
+                break;
+            case GameEventType::PROP_USED:
+                if (event.prop.prop > 2) {
+                    continue;
+                }
+                item.prop = event.prop.prop;
+                item.propAffected = event.prop.affected;
+                break;
+            case GameEventType::ROUND_RESOLVED:
+                continue;  // 轮次结算不单独触发成就
+        }
+        
+        if (eventRing_.push(item)) {
+            pushed = true;
+        } else if (++droppedEvents_ % 100 == 1) {
+            qWarning() << "Achievement event ring full, dropped events:" << droppedEvents_;
+        }
+    }
+    
+    if (pushed && !drainScheduled_.exchange(true, std::memory_order_acq_rel)) {
+        emit eventsPending();
+    }
+}
+
 /**
  * @brief 记录游戏会话开始/结束（新统一接口）
  * 
  * 这是主循环推荐调用的接口，让成就系统自主管理会话生命周期
  */
-void AchievementManager::recordGameSession(const QString& mode, bool isStarting)
+void AchievementManager::recordGameSession(const QString& mode, bool isStarting,
+                                           const GameDataSnapshot& endSnapshot)
 {
     if (isStarting) {
         onGameStart(mode);
     } else {
-        // 游戏结束时传递当前快照
-        onGameEnd(currentGameData_);
+        // 游戏结束时使用引擎构建的完整会话快照
+        onGameEnd(endSnapshot);
     }
 }
 
@@ -329,8 +404,12 @@ void AchievementManager::handleAchievementUnlocked(const AchievementNotification
 
 // ==================== AchievementWorker 实现 ====================
 
-AchievementWorker::AchievementWorker(const QMap<QString, AchievementDef>* achievements)
+AchievementWorker::AchievementWorker(const QMap<QString, AchievementDef>* achievements,
+                                     AchievementEventRing* eventRing,
+                                     std::atomic<bool>* drainScheduled)
     : achievements_(achievements)
+    , eventRing_(eventRing)
+    , drainScheduled_(drainScheduled)
     , currentPlayerId_(Database::instance().getCurrentPlayerId())
     , gameEngine_(nullptr)
     , detectorManager_(nullptr)
@@ -361,6 +440,9 @@ AchievementWorker::AchievementWorker(const QMap<QString, AchievementDef>* achiev
 
 AchievementWorker::~AchievementWorker()
 {
+    // 退出前写回未落盘的进度
+    flushProgress();
+    
     if (detectorManager_) {
         delete detectorManager_;
         detectorManager_ = nullptr;
@@ -372,6 +454,11 @@ AchievementWorker::~AchievementWorker()
  */
 void AchievementWorker::setCurrentPlayerId(const QString& playerId)
 {
+    // 切换账号前先写回上一个玩家的进度
+    flushProgress();
+    progressCache_.clear();
+    progressCacheLoaded_ = false;
+    
     currentPlayerId_ = playerId;
     // 清空上一个玩家的缓存
     triggeredThisSession_.clear();
@@ -403,57 +490,144 @@ void AchievementWorker::setCurrentPlayerId(const QString& playerId)
 void AchievementWorker::onGameStarted(const QString& mode)
 {
     triggeredThisSession_.clear();
+    sessionMode_ = mode;
+    sessionStartTime_ = QDateTime::currentMSecsSinceEpoch();
     
     // 游客模式：不从数据库加载
     if (currentPlayerId_ == "guest") {
+        if (detectorManager_) {
+            detectorManager_->resetCompletedAchievements(triggeredThisSession_);
+        }
         return;
     }
     
     // 📌 关键修复: 每次游戏启动时，都要从数据库重新加载该玩家的成就状态
-    // 确保已完成或已领取的成就不会在同一会话内重复触发
+    // 确保已完成或已领取的成就不会在同一会话内重复触发（重新加载前先写回残留的修改）
+    flushProgress();
+    loadProgressCache();
     
-    QList<AchievementProgress> allProgress = Database::instance()
-        .getAllAchievementProgress(currentPlayerId_);
+    // 定时写回（兜底：长时间无事件结束时也能落盘）
+    if (!flushTimer_) {
+        flushTimer_ = new QTimer(this);
+        flushTimer_->setInterval(3000);
+        connect(flushTimer_, &QTimer::timeout, this, &AchievementWorker::flushProgress);
+    }
+    flushTimer_->start();
     
-    for (const auto& progress : allProgress) {
-        if (progress.state == AchievementState::COMPLETED || 
-            progress.state == AchievementState::CLAIMED) {
-            triggeredThisSession_.insert(progress.achievementId);
-        }
+    // 已全部完成的检测器不再参与分发
+    if (detectorManager_) {
+        detectorManager_->resetCompletedAchievements(triggeredThisSession_);
     }
 }
 
 
 void AchievementWorker::onGameDataReceived(const GameDataSnapshot& snapshot)
 {
-    checkAllAchievements(snapshot);
+    checkAllAchievements(snapshot, DetectorEvent::GENERIC);
+    flushProgress();
+}
+
+/**
+ * @brief 批量处理环形队列中的事件
+ * 
+ * 先清除唤醒标记再取数据：取数期间新入队的事件要么本轮取到，要么会重新投递唤醒信号
+ */
+void AchievementWorker::drainEvents()
+{
+    static const char* const kSpecialNames[] = { "", "LINE_H", "LINE_V", "DIAMOND", "RAINBOW" };
+    static const char* const kPropNames[] = { "Hammer", "Clamp", "MagicWand" };
+    
+    drainScheduled_->store(false, std::memory_order_release);
+    
+    AchievementEvent batch[64];
+    size_t count = 0;
+    while ((count = eventRing_->popBatch(batch, 64)) > 0) {
+        for (size_t i = 0; i < count; i++) {
+            const AchievementEvent& event = batch[i];
+            
+            GameDataSnapshot snapshot;
+            DetectorEvent detectorEvent = DetectorEvent::GENERIC;
+            snapshot.currentScore = event.currentScore;
+            snapshot.eliminateCount = event.eliminateCount;
+            snapshot.propUsed = event.propUsed;
+            snapshot.gameMode = sessionMode_;
+            snapshot.gameStartTime = sessionStartTime_;
+            
+            switch (event.kind) {
+                case GameEventType::MATCH_FORMED:
+                    snapshot.lastMatchSize = event.matchSize;
+                    snapshot.lastMatchElementType = event.matchElementType;
+                    snapshot.lastMatchSameElement = true;  // 每个匹配组内部必然是同类型
+                    snapshot.currentCombo = event.combo;
+                    detectorEvent = DetectorEvent::MATCH;
+                    break;
+                case GameEventType::SPECIAL_CREATED:
+                    snapshot.specialGenerated = QString::fromLatin1(kSpecialNames[event.special]);
+                    detectorEvent = DetectorEvent::SPECIAL_CREATED;
+                    break;
+                case GameEventType::SPECIAL_TRIGGERED:
+                    snapshot.specialUsed = QString::fromLatin1(kSpecialNames[event.special]);
+                    detectorEvent = DetectorEvent::SPECIAL_TRIGGERED;
+                    break;
+                case GameEventType::PROP_USED:
+                    snapshot.propUsedType = QString::fromLatin1(kPropNames[event.prop]);
+                    snapshot.propChainEliminate = event.propAffected;
+                    detectorEvent = DetectorEvent::PROP_USED;
+                    break;
+                default:
+                    continue;
+            }
+            
+            checkAllAchievements(snapshot, detectorEvent);
+        }
+    }
+    
+    // 一批事件对应一次玩家操作（所有轮次已结算），合并写回
+    flushProgress();
 }
 
 void AchievementWorker::onGameEnded(const GameDataSnapshot& snapshot)
 {
     // 最后一次检测（比如游戏结束成就）
-    checkAllAchievements(snapshot);
+    checkAllAchievements(snapshot, DetectorEvent::GAME_END);
     
     // 统计本局数据
     cumulativeStats_.totalGames++;
+    
+    // 游戏结束：写回全部进度并停止定时器
+    flushProgress();
+    if (flushTimer_) {
+        flushTimer_->stop();
+    }
 }
 
 /**
  * @brief 检测所有成就类别（使用模块化检测器）
  */
-void AchievementWorker::checkAllAchievements(const GameDataSnapshot& snapshot)
+void AchievementWorker::checkAllAchievements(const GameDataSnapshot& snapshot, DetectorEvent event)
 {
     if (!detectorManager_) {
         qWarning() << "DetectorManager not initialized!";
         return;
     }
     
-    // 使用检测器管理器进行所有成就检测
-    detectorManager_->detectAll(snapshot, [this](const QString& achievementId, int currentValue, int targetValue) {
+    // 按事件类型分发给相关检测器
+    detectorManager_->detect(event, snapshot, [this](const QString& achievementId, int currentValue, int targetValue) {
         updateProgress(achievementId, currentValue, targetValue);
     });
 }
 
+/**
+ * @brief 记录本局已触发（完成/领取）的成就，并同步给检测器分发表
+ */
+void AchievementWorker::markTriggered(const QString& achievementId)
+{
+    triggeredThisSession_.insert(achievementId);
+    if (detectorManager_) {
+        detectorManager_->markAchievementCompleted(achievementId);
+    }
+}
+
 /**
  * @brief 更新成就进度
  * @return true 如果成就已完成或新完成
@@ -468,42 +642,114 @@ bool AchievementWorker::updateProgress(const QString& achievementId, int current
     // 游客模式：内存状态跟踪
     if (currentPlayerId_ == "guest") {
         if (currentValue >= targetValue) {
-            triggeredThisSession_.insert(achievementId);
+            markTriggered(achievementId);
             notifyUnlock(achievementId);
             return true;
         }
         return false;
     }
     
-    // 查询数据库中该成就的当前状态
-    AchievementProgress progress = Database::instance()
-        .getAchievementProgress(currentPlayerId_, achievementId);
+    // 从内存表读取该成就的当前状态（不在表中时视为未开始）
+    if (!progressCacheLoaded_) {
+        loadProgressCache();
+    }
+    CachedProgress& progress = progressCache_[achievementId];
     
     // 已领取或已完成的成就不再处理
-    if (progress.state == AchievementState::CLAIMED) {
-        return false;
-    }
-    if (progress.state == AchievementState::COMPLETED) {
-        triggeredThisSession_.insert(achievementId);
+    if (progress.state == AchievementState::CLAIMED ||
+        progress.state == AchievementState::COMPLETED) {
+        markTriggered(achievementId);
         return false;
     }
     
-    // 更新进度
+    // 更新进度（只改内存，稍后合并写回）
     if (currentValue > progress.currentValue) {
-        Database::instance().updateAchievementProgress(currentPlayerId_, achievementId, currentValue);
+        progress.currentValue = currentValue;
+        progress.dirty = true;
     }
     
-    // 检查是否完成
-    if (currentValue >= targetValue && progress.state == AchievementState::LOCKED) {
-        Database::instance().completeAchievement(currentPlayerId_, achievementId);
-        triggeredThisSession_.insert(achievementId);
-        notifyUnlock(achievementId);
+    // 检查是否完成：写回成功后再通知，保证通知过的成就一定已落盘
+    if (currentValue >= targetValue) {
+        progress.state = AchievementState::COMPLETED;
+        progress.dirty = true;
+        markTriggered(achievementId);
+        pendingUnlocks_.append(achievementId);
         return true;
     }
     
     return false;
 }
 
+/**
+ * @brief 从数据库整表加载当前玩家的成就进度
+ */
+void AchievementWorker::loadProgressCache()
+{
+    progressCache_.clear();
+    progressCacheLoaded_ = true;
+    
+    QList<AchievementProgress> allProgress = Database::instance()
+        .getAllAchievementProgress(currentPlayerId_);
+    
+    for (const auto& progress : allProgress) {
+        CachedProgress cached;
+        cached.currentValue = progress.currentValue;
+        cached.state = progress.state;
+        progressCache_.insert(progress.achievementId, cached);
+        
+        if (progress.state == AchievementState::COMPLETED || 
+            progress.state == AchievementState::CLAIMED) {
+            triggeredThisSession_.insert(progress.achievementId);
+        }
+    }
+}
+
+/**
+ * @brief 写回脏的成就进度
+ * 
+ * 顺序保证：
+ * 1. 进度与完成状态在同一事务中写入（事务内先进度后完成）
+ * 2. 提交成功后才清除脏标记并发出解锁通知；失败则保留，等待下次写回重试
+ */
+void AchievementWorker::flushProgress()
+{
+    if (currentPlayerId_ == "guest" || !progressCacheLoaded_) {
+        return;
+    }
+    
+    QList<AchievementProgress> dirtyList;
+    for (auto it = progressCache_.constBegin(); it != progressCache_.constEnd(); ++it) {
+        if (it.value().dirty) {
+            AchievementProgress progress;
+            progress.playerId = currentPlayerId_;
+            progress.achievementId = it.key();
+            progress.currentValue = it.value().currentValue;
+            progress.state = it.value().state;
+            dirtyList.append(progress);
+        }
+    }
+    
+    if (dirtyList.isEmpty() && pendingUnlocks_.isEmpty()) {
+        return;
+    }
+    
+    if (!Database::instance().saveAchievementProgressBatch(currentPlayerId_, dirtyList)) {
+        qWarning() << "Achievement progress flush failed, will retry:" << dirtyList.size() << "entries";
+        return;
+    }
+    
+    for (const auto& progress : dirtyList) {
+        progressCache_[progress.achievementId].dirty = false;
+    }
+    
+    // 已落盘，发出解锁通知
+    const QStringList unlocks = pendingUnlocks_;
+    pendingUnlocks_.clear();
+    for (const QString& achievementId : unlocks) {
+        notifyUnlock(achievementId);
+    }
+}
+
 /**
  * @brief 发送成就解锁通知
  */
@@ -2,16 +2,24 @@
 #define ACHIEVEMENTMANAGER_H
 
 #include "AchievementDef.h"
+#include "../data/Database.h"
+#include "../core/GameEventBus.h"
+#include "SpscRing.h"
 #include <QObject>
 #include <QMap>
+#include <QHash>
+#include <QStringList>
 #include <QThread>
 #include <QMutex>
 #include <QString>
 #include <QSet>
 #include <functional>
+#include <atomic>
 
 // 前向声明
 class AchievementWorker;
+class QTimer;
+enum class DetectorEvent;
 class GameEngine;
 
 /**
@@ -57,6 +65,26 @@ struct GameDataSnapshot {
     QSet<int> fruitTypesEliminated; // 本局消除过的水果类型
 };
 
+/**
+ * @brief 成就事件（主线程→工作线程，POD，经无锁环形队列传递）
+ * 
+ * 会话级数据（游戏模式、开始时间）由工作线程在 onGameStarted 时记录，不随事件传递
+ */
+struct AchievementEvent {
+    GameEventType kind;             // 事件类型（MATCH_FORMED/SPECIAL_CREATED/SPECIAL_TRIGGERED/PROP_USED）
+    int8_t matchElementType;        // 匹配组水果类型
+    uint8_t matchSize;              // 匹配组数量
+    uint8_t special;                // SpecialType
+    uint8_t prop;                   // PropType
+    bool propUsed;                  // 本局是否使用过道具
+    uint16_t combo;                 // 当前连击
+    uint16_t propAffected;          // 道具直接影响格数
+    int32_t currentScore;           // 当前得分
+    int32_t eliminateCount;         // 本局消除次数
+};
+
+using AchievementEventRing = SpscRing<AchievementEvent, 4096>;
+
 /**
  * @brief 成就通知数据
  */
@@ -76,15 +104,20 @@ struct AchievementNotification {
  * 负责：
  * - 管理所有成就定义
  * - 启动成就监听线程
- * - 接收游戏数据快照
+ * - 订阅引擎事件并生成游戏数据快照
  * - 发送成就解锁通知
  */
-class AchievementManager : public QObject {
+class AchievementManager : public QObject, public IGameEventObserver {
     Q_OBJECT
     
 public:
     static AchievementManager& instance();
     
+    /**
+     * @brief 引擎事件订阅回调：把匹配、特殊元素、道具事件转换为成就快照
+     */
+    void onGameEvents(const GameEvent* events, int count) override;
+    
     // 初始化和清理
     void initialize();
     void shutdown();
@@ -94,7 +127,8 @@ public:
     AchievementDef getAchievement(const QString& achievementId) const;
     
     // 游戏数据接收（统一入口，从主循环调用）
-    void recordGameSession(const QString& mode, bool isStarting);  // 游戏开始/结束
+    void recordGameSession(const QString& mode, bool isStarting,
+                           const GameDataSnapshot& endSnapshot = GameDataSnapshot());  // 游戏开始/结束（结束时附带会话快照）
     void recordGameSnapshot(const GameDataSnapshot& snapshot);     // 游戏数据快照（每次消除时调用）
     
     // 游戏事件通知（向后兼容）
@@ -118,7 +152,8 @@ public:
     
 signals:
     // 发送数据到工作线程
-    void gameDataReceived(const GameDataSnapshot& snapshot);
+    void gameDataReceived(const GameDataSnapshot& snapshot);  // 兼容接口（引擎事件走 eventRing_）
+    void eventsPending();                                      // 环形队列有新事件，唤醒工作线程
     void gameStarted(const QString& mode);
     void gameEnded(const GameDataSnapshot& snapshot);
     
@@ -145,6 +180,10 @@ private:
     
     GameDataSnapshot currentGameData_;                 // 当前游戏会话数据
     QMutex dataMutex_;                                 // 数据保护锁
+    
+    AchievementEventRing eventRing_;                   // 引擎事件无锁队列（主线程写，工作线程读）
+    std::atomic<bool> drainScheduled_{false};          // 是否已投递唤醒信号（避免每个事件都入Qt事件队列）
+    int droppedEvents_ = 0;                            // 队列满时丢弃的事件数
 };
 
 /**
@@ -160,7 +199,9 @@ class AchievementWorker : public QObject {
     Q_OBJECT
     
 public:
-    explicit AchievementWorker(const QMap<QString, AchievementDef>* achievements);
+    AchievementWorker(const QMap<QString, AchievementDef>* achievements,
+                      AchievementEventRing* eventRing,
+                      std::atomic<bool>* drainScheduled);
     ~AchievementWorker();
     
     // 设置游戏引擎实例（在成就完成时用于添加分数奖励）
@@ -175,23 +216,42 @@ public slots:
     void onGameDataReceived(const GameDataSnapshot& snapshot);
     void onGameStarted(const QString& mode);
     void onGameEnded(const GameDataSnapshot& snapshot);
+    void drainEvents();  // 批量取出环形队列中的事件并检测
+    void flushProgress();  // 把脏的成就进度在一个事务中写回数据库
     
 signals:
     void achievementUnlocked(const AchievementNotification& notification);
     
 private:
-    void checkAllAchievements(const GameDataSnapshot& snapshot);
+    void checkAllAchievements(const GameDataSnapshot& snapshot, DetectorEvent event);
+    void markTriggered(const QString& achievementId);
     
     bool updateProgress(const QString& achievementId, int currentValue, int targetValue);
+    void loadProgressCache();
     void notifyUnlock(const QString& achievementId);
     
     const QMap<QString, AchievementDef>* achievements_;
+    AchievementEventRing* eventRing_;               // 事件队列（由 AchievementManager 持有）
+    std::atomic<bool>* drainScheduled_;             // 唤醒标记（由 AchievementManager 持有）
+    QString sessionMode_;                           // 当前会话游戏模式
+    qint64 sessionStartTime_ = 0;                   // 当前会话开始时间(ms)
     QString currentPlayerId_;
     GameEngine* gameEngine_;                        // 游戏引擎实例（用于添加奖励分数）
     
     // 已触发成就缓存（本局）
     QSet<QString> triggeredThisSession_;
     
+    // 成就进度内存表（onGameStarted 时整表加载，写回采用 write-behind）
+    struct CachedProgress {
+        int currentValue = 0;
+        AchievementState state = AchievementState::LOCKED;
+        bool dirty = false;                         // 是否有未写回的修改
+    };
+    QHash<QString, CachedProgress> progressCache_;
+    bool progressCacheLoaded_ = false;
+    QStringList pendingUnlocks_;                    // 已完成但尚未写回的成就（写回成功后才通知）
+    QTimer* flushTimer_ = nullptr;                  // 定时写回（工作线程内创建）
+    
     // 累计统计数据（跨局）
     struct CumulativeStats {
         int totalGames = 0;
@@ -0,0 +1,65 @@
+#ifndef SPSCRING_H
+#define SPSCRING_H
+
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @brief 定长无锁单生产者/单消费者环形队列
+ * 
+ * - 生产者线程只调用 push，消费者线程只调用 popBatch
+ * - 容量必须是2的幂，下标用掩码回绕
+ * - 元素应为 POD 类型，入队/出队都是按值拷贝，不分配内存
+ */
+template <typename T, size_t Capacity>
+class SpscRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "SpscRing capacity must be a power of two");
+    
+public:
+    SpscRing() = default;
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+    
+    /**
+     * @brief 入队（生产者线程）
+     * @return 队列已满时返回false
+     */
+    bool push(const T& item) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) >= Capacity) {
+            return false;
+        }
+        buffer_[tail & (Capacity - 1)] = item;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+    
+    /**
+     * @brief 批量出队（消费者线程）
+     * @param out 输出数组
+     * @param maxCount 最多取出的数量
+     * @return 实际取出的数量
+     */
+    size_t popBatch(T* out, size_t maxCount) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        const size_t available = tail_.load(std::memory_order_acquire) - head;
+        const size_t count = available < maxCount ? available : maxCount;
+        for (size_t i = 0; i < count; i++) {
+            out[i] = buffer_[(head + i) & (Capacity - 1)];
+        }
+        head_.store(head + count, std::memory_order_release);
+        return count;
+    }
+    
+    bool isEmpty() const {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+    
+private:
+    alignas(64) std::atomic<size_t> head_{0};  ///< 消费者读位置
+    alignas(64) std::atomic<size_t> tail_{0};  ///< 生产者写位置
+    T buffer_[Capacity];
+};
+
+#endif // SPSCRING_H
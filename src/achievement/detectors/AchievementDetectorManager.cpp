@@ -25,6 +25,7 @@ void AchievementDetectorManager::registerDetector(std::unique_ptr<IAchievementDe
     // 释放所有权给指针并存储
     IAchievementDetector* rawPtr = detector.release();
     detectors_.push_back(rawPtr);
+    rebuildIndex();
     
     qDebug() << "Registered achievement detector:" << rawPtr->getName();
 }
@@ -40,6 +41,7 @@ void AchievementDetectorManager::unregisterDetector(const QString& detectorName)
     if (it != detectors_.end()) {
         delete *it;
         detectors_.erase(it);
+        rebuildIndex();
         qDebug() << "Unregistered achievement detector:" << detectorName;
         return;
     }
@@ -58,6 +60,80 @@ void AchievementDetectorManager::detectAll(
     }
 }
 
+void AchievementDetectorManager::detect(
+    DetectorEvent event,
+    const GameDataSnapshot& snapshot,
+    std::function<void(const QString&, int, int)> callback
+)
+{
+    // 只调用订阅了该事件且仍有未完成成就的检测器
+    for (int index : dispatch_[static_cast<int>(event)]) {
+        if (remaining_[index] > 0) {
+            detectors_[index]->detect(snapshot, callback);
+        }
+    }
+}
+
+void AchievementDetectorManager::resetCompletedAchievements(const QSet<QString>& completed)
+{
+    completed_ = completed;
+    rebuildIndex();
+}
+
+void AchievementDetectorManager::markAchievementCompleted(const QString& achievementId)
+{
+    if (completed_.contains(achievementId)) {
+        return;
+    }
+    completed_.insert(achievementId);
+    
+    auto it = achievementOwner_.constFind(achievementId);
+    if (it != achievementOwner_.constEnd()) {
+        remaining_[it.value()]--;
+    }
+}
+
+/**
+ * @brief 重建事件分发表和成就归属表
+ * 
+ * 每种事件携带的字段固定，检测器依赖字段与之有交集才会被分发
+ */
+void AchievementDetectorManager::rebuildIndex()
+{
+    static const uint32_t kEventFields[static_cast<int>(DetectorEvent::COUNT)] = {
+        FIELD_SCORE | FIELD_TIMING | FIELD_COMBO | FIELD_MATCH,     // MATCH
+        FIELD_SCORE | FIELD_TIMING | FIELD_SPECIAL,                 // SPECIAL_CREATED
+        FIELD_SCORE | FIELD_TIMING | FIELD_SPECIAL,                 // SPECIAL_TRIGGERED
+        FIELD_SCORE | FIELD_TIMING | FIELD_PROP,                    // PROP_USED
+        FIELD_SCORE | FIELD_TIMING | FIELD_COMBO | FIELD_SESSION,   // GAME_END
+        FIELD_ALL                                                   // GENERIC
+    };
+    
+    achievementOwner_.clear();
+    remaining_.clear();
+    for (auto& list : dispatch_) {
+        list.clear();
+    }
+    
+    for (int i = 0; i < detectors_.size(); i++) {
+        const uint32_t fields = detectors_[i]->getDependentFields();
+        for (int e = 0; e < static_cast<int>(DetectorEvent::COUNT); e++) {
+            if (fields & kEventFields[e]) {
+                dispatch_[e].append(i);
+            }
+        }
+        
+        int remaining = 0;
+        for (const QString& achievementId : detectors_[i]->getResponsibleAchievements()) {
+            achievementOwner_.insert(achievementId, i);
+            if (!completed_.contains(achievementId)) {
+                remaining++;
+            }
+        }
+        remaining_.append(remaining);
+    }
+}
+
 QSet<QString> AchievementDetectorManager::getAllResponsibleAchievements() const
 {
     QSet<QString> allAchievements;
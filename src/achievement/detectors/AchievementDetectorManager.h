@@ -3,6 +3,7 @@
 
 #include "IAchievementDetector.h"
 #include <QVector>
+#include <QHash>
 #include <memory>
 
 /**
@@ -10,8 +11,9 @@
  * 
  * 负责：
  * 1. 管理所有的成就检测器实例
- * 2. 在每次游戏数据更新时，依次调用所有检测器
- * 3. 统一处理检测结果的回调
+ * 2. 按事件类型只调用依赖相关字段的检测器（分发表在注册时建立）
+ * 3. 跳过负责的成就已全部完成/领取的检测器
+ * 4. 统一处理检测结果的回调
  * 
  * 使用组合模式（Composite Pattern）将多个检测器组织在一起，
  * 提供统一的检测接口。
@@ -50,6 +52,29 @@ public:
         std::function<void(const QString&, int, int)> callback
     );
 
+    /**
+     * @brief 按事件类型分发检测
+     * @param event 事件类型
+     * @param snapshot 游戏数据快照
+     * @param callback 检测结果回调 (achievementId, currentValue, targetValue)
+     */
+    void detect(
+        DetectorEvent event,
+        const GameDataSnapshot& snapshot,
+        std::function<void(const QString&, int, int)> callback
+    );
+
+    /**
+     * @brief 用当前玩家已完成/已领取的成就重置完成状态
+     * @param completed 已完成或已领取的成就ID集合
+     */
+    void resetCompletedAchievements(const QSet<QString>& completed);
+
+    /**
+     * @brief 标记单个成就已完成（负责的成就全部完成后检测器不再被调用）
+     */
+    void markAchievementCompleted(const QString& achievementId);
+
     /**
      * @brief 获取所有已注册的检测器
      * @return 检测器列表
@@ -67,7 +92,16 @@ public:
     QSet<QString> getAllResponsibleAchievements() const;
 
 private:
+    /**
+     * @brief 重建事件分发表和成就归属表
+     */
+    void rebuildIndex();
+
     QVector<IAchievementDetector*> detectors_;  // 所有检测器指针列表
+    QVector<int> dispatch_[static_cast<int>(DetectorEvent::COUNT)];  // 事件类型 → 检测器下标
+    QHash<QString, int> achievementOwner_;      // 成就ID → 检测器下标
+    QVector<int> remaining_;                    // 每个检测器尚未完成的成就数
+    QSet<QString> completed_;                   // 已完成的成就
 };
 
 #endif // ACHIEVEMENTDETECTORMANAGER_H
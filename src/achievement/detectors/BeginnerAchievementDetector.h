@@ -21,6 +21,8 @@ public:
 
     QString getName() const override { return "BeginnerAchievementDetector"; }
 
+    uint32_t getDependentFields() const override { return FIELD_MATCH | FIELD_SCORE | FIELD_SPECIAL; }
+
     QSet<QString> getResponsibleAchievements() const override {
         return {
             "ach_first_match",
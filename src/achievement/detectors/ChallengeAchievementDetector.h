@@ -24,6 +24,8 @@ public:
 
     QString getName() const override { return "ChallengeAchievementDetector"; }
 
+    uint32_t getDependentFields() const override { return FIELD_SCORE | FIELD_TIMING; }
+
     QSet<QString> getResponsibleAchievements() const override {
         return {
             "ach_challenge_60s", "ach_challenge_flash",
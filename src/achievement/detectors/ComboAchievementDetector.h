@@ -22,6 +22,8 @@ public:
 
     QString getName() const override { return "ComboAchievementDetector"; }
 
+    uint32_t getDependentFields() const override { return FIELD_COMBO; }
+
     QSet<QString> getResponsibleAchievements() const override {
         return {
             "ach_combo_3", "ach_combo_5", "ach_combo_8", 
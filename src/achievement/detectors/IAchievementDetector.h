@@ -5,6 +5,34 @@
 #include <QString>
 #include <QSet>
 #include <functional>
+#include <cstdint>
+
+/**
+ * @brief 检测事件类型（决定本次快照中哪些字段有效）
+ */
+enum class DetectorEvent {
+    MATCH,              ///< 匹配组消除
+    SPECIAL_CREATED,    ///< 生成特殊元素
+    SPECIAL_TRIGGERED,  ///< 引爆特殊元素
+    PROP_USED,          ///< 使用道具
+    GAME_END,           ///< 游戏结束（本局汇总数据）
+    GENERIC,            ///< 未分类快照（兼容接口，分发给所有检测器）
+    COUNT
+};
+
+/**
+ * @brief 快照字段分组（检测器声明依赖，用于按事件类型分发）
+ */
+enum SnapshotField : uint32_t {
+    FIELD_SCORE   = 1u << 0,  ///< currentScore / eliminateCount / propUsed（所有事件都携带）
+    FIELD_TIMING  = 1u << 1,  ///< gameStartTime（所有事件都携带）
+    FIELD_COMBO   = 1u << 2,  ///< currentCombo / maxCombo / isComboTrigger
+    FIELD_MATCH   = 1u << 3,  ///< lastMatchSize / lastMatchElementType / lastMatchSameElement
+    FIELD_SPECIAL = 1u << 4,  ///< specialGenerated / specialUsed / comboPairType
+    FIELD_PROP    = 1u << 5,  ///< propUsedType / propChainEliminate
+    FIELD_SESSION = 1u << 6,  ///< 本局汇总（N消次数、消除过的水果类型、局数等）
+    FIELD_ALL     = 0xFFFFFFFFu
+};
 
 /**
  * @brief 成就检测器抽象基类
@@ -51,6 +79,13 @@ public:
      * @return 成就ID集合
      */
     virtual QSet<QString> getResponsibleAchievements() const = 0;
+
+    /**
+     * @brief 返回此检测器依赖的快照字段（SnapshotField 位掩码）
+     * 
+     * 管理器据此建立事件类型→检测器的分发表，只有携带相关字段的事件才会调用此检测器
+     */
+    virtual uint32_t getDependentFields() const = 0;
 };
 
 #endif // IACHIEVEMENTDETECTOR_H
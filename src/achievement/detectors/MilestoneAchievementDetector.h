@@ -25,6 +25,8 @@ public:
 
     QString getName() const override { return "MilestoneAchievementDetector"; }
 
+    uint32_t getDependentFields() const override { return FIELD_SESSION; }
+
     QSet<QString> getResponsibleAchievements() const override {
         return {
             "ach_first_game", "ach_5_games",
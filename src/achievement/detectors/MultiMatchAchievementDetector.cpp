@@ -7,6 +7,14 @@ void MultiMatchAchievementDetector::detect(
 {
     int matchSize = snapshot.lastMatchSize;
     
+    // 单局N+消次数（GAME_END 的本局汇总携带，匹配事件中为 0）
+    if (snapshot.match5PlusCount > 0) {
+        callback("ach_match5plus_3", snapshot.match5PlusCount, 3);
+    }
+    if (snapshot.match6PlusCount > 0) {
+        callback("ach_match6plus_5", snapshot.match6PlusCount, 5);
+    }
+    
     // 📌 修复问题 #1: 只在元素相同时计数N消
     if (!snapshot.lastMatchSameElement) {
         return;  // 如果不是全相同元素，不计为多消成就
@@ -35,12 +43,4 @@ void MultiMatchAchievementDetector::detect(
     callback("ach_match5_50", totalMatch5_, 50);
     callback("ach_match6_20", totalMatch6_, 20);
     callback("ach_match8_10", totalMatch8_, 10);
-    
-    // 单局N+消次数
-    if (matchSize >= 5) {
-        callback("ach_match5plus_3", snapshot.match5PlusCount, 3);
-    }
-    if (matchSize >= 6) {
-        callback("ach_match6plus_5", snapshot.match6PlusCount, 5);
-    }
 }
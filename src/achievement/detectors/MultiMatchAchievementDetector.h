@@ -28,6 +28,8 @@ public:
 
     QString getName() const override { return "MultiMatchAchievementDetector"; }
 
+    uint32_t getDependentFields() const override { return FIELD_MATCH | FIELD_SESSION; }
+
     QSet<QString> getResponsibleAchievements() const override {
         return {
             "ach_match4_first", "ach_match5_first", 
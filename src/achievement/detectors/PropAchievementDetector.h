@@ -23,6 +23,8 @@ public:
 
     QString getName() const override { return "PropAchievementDetector"; }
 
+    uint32_t getDependentFields() const override { return FIELD_PROP; }
+
     QSet<QString> getResponsibleAchievements() const override {
         return {
             "ach_prop_hammer_first", "ach_prop_clamp_first",
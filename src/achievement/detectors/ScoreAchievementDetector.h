@@ -20,6 +20,8 @@ public:
 
     QString getName() const override { return "ScoreAchievementDetector"; }
 
+    uint32_t getDependentFields() const override { return FIELD_SCORE; }
+
     QSet<QString> getResponsibleAchievements() const override {
         return {
             "ach_score_1k", "ach_score_5k", "ach_score_10k",
@@ -27,6 +27,8 @@ public:
 
     QString getName() const override { return "SpecialAchievementDetector"; }
 
+    uint32_t getDependentFields() const override { return FIELD_SPECIAL; }
+
     QSet<QString> getResponsibleAchievements() const override {
         return {
             "ach_special_first", "ach_line_50", 
@@ -0,0 +1,94 @@
+#include "BoardSerializer.h"
+#include <QtEndian>
+#include <cstring>
+
+namespace {
+const char kMagic[4] = { 'F', 'C', 'B', '1' };
+const int kHeaderSize = 8;
+}
+
+QByteArray BoardSerializer::encode(const std::vector<std::vector<Fruit>>& map, int mapSize,
+                                   const std::vector<uint32_t>& rngState) {
+    const int rngWords = static_cast<int>(rngState.size());
+    const int cellCount = mapSize * mapSize;
+    
+    QByteArray data(kHeaderSize + rngWords * 4 + cellCount, '\0');
+    uchar* out = reinterpret_cast<uchar*>(data.data());
+    
+    // 1. 文件头
+    std::memcpy(out, kMagic, 4);
+    out[4] = FORMAT_VERSION;
+    out[5] = static_cast<uchar>(mapSize);
+    qToLittleEndian<quint16>(static_cast<quint16>(rngWords), out + 6);
+    out += kHeaderSize;
+    
+    // 2. 随机数状态
+    for (int i = 0; i < rngWords; i++) {
+        qToLittleEndian<quint32>(rngState[i], out + i * 4);
+    }
+    out += rngWords * 4;
+    
+    // 3. 棋盘单元格（行优先）
+    for (int row = 0; row < mapSize; row++) {
+        for (int col = 0; col < mapSize; col++) {
+            *out++ = packCell(map[row][col].type, map[row][col].special);
+        }
+    }
+    
+    return data;
+}
+
+bool BoardSerializer::decode(const QByteArray& data, std::vector<std::vector<Fruit>>& outMap,
+                             int& outMapSize, std::vector<uint32_t>& outRngState) {
+    // 1. 校验文件头
+    if (data.size() < kHeaderSize) {
+        return false;
+    }
+    const uchar* in = reinterpret_cast<const uchar*>(data.constData());
+    if (std::memcmp(in, kMagic, 4) != 0 || in[4] != FORMAT_VERSION) {
+        return false;
+    }
+    
+    const int mapSize = in[5];
+    const int rngWords = qFromLittleEndian<quint16>(in + 6);
+    const int cellCount = mapSize * mapSize;
+    if (mapSize <= 0 || data.size() != kHeaderSize + rngWords * 4 + cellCount) {
+        return false;
+    }
+    in += kHeaderSize;
+    
+    // 2. 随机数状态
+    std::vector<uint32_t> rngState(rngWords);
+    for (int i = 0; i < rngWords; i++) {
+        rngState[i] = qFromLittleEndian<quint32>(in + i * 4);
+    }
+    in += rngWords * 4;
+    
+    // 3. 棋盘单元格：整块拷贝后逐格解包并校验
+    std::vector<uint8_t> cells(cellCount);
+    std::memcpy(cells.data(), in, cellCount);
+    
+    std::vector<std::vector<Fruit>> map(mapSize, std::vector<Fruit>(mapSize));
+    for (int row = 0; row < mapSize; row++) {
+        for (int col = 0; col < mapSize; col++) {
+            const uint8_t packed = cells[row * mapSize + col];
+            FruitType type = unpackCellType(packed);
+            SpecialType special = unpackCellSpecial(packed);
+            if (type == FruitType::EMPTY || static_cast<int>(type) > static_cast<int>(FruitType::EMPTY) ||
+                static_cast<int>(special) > static_cast<int>(SpecialType::RAINBOW)) {
+                return false;  // 存档棋盘必须是已稳定的满盘
+            }
+            
+            Fruit& fruit = map[row][col];
+            fruit.type = type;
+            fruit.special = special;
+            fruit.row = row;
+            fruit.col = col;
+        }
+    }
+    
+    outMap.swap(map);
+    outMapSize = mapSize;
+    outRngState.swap(rngState);
+    return true;
+}
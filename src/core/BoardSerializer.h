@@ -0,0 +1,48 @@
+#ifndef BOARDSERIALIZER_H
+#define BOARDSERIALIZER_H
+
+#include "FruitTypes.h"
+#include <QByteArray>
+#include <vector>
+#include <cstdint>
+
+/**
+ * @brief 棋盘存档序列化器 - 将休闲模式棋盘压缩为二进制数据
+ * 
+ * 数据格式（小端序）：
+ * - [0,4)   魔数 "FCB1"
+ * - [4]     格式版本
+ * - [5]     地图大小 N
+ * - [6,8)   随机数状态字数量 K
+ * - [8, 8+4K)            随机数生成器状态
+ * - [8+4K, 8+4K+N*N)     棋盘单元格，每格1字节（见 packCell）
+ * 
+ * 60x60 棋盘约 6KB，解码只需一次内存拷贝加逐格解包
+ */
+class BoardSerializer {
+public:
+    static constexpr uint8_t FORMAT_VERSION = 1;
+    
+    /**
+     * @brief 编码棋盘
+     * @param map 游戏地图
+     * @param mapSize 地图大小
+     * @param rngState 随机数生成器状态（FruitGenerator::saveRngState）
+     * @return 二进制数据
+     */
+    static QByteArray encode(const std::vector<std::vector<Fruit>>& map, int mapSize,
+                             const std::vector<uint32_t>& rngState);
+    
+    /**
+     * @brief 解码棋盘
+     * @param data 二进制数据
+     * @param outMap 输出地图（会被重新分配）
+     * @param outMapSize 输出地图大小
+     * @param outRngState 输出随机数生成器状态
+     * @return 数据是否有效（无效时输出参数不变）
+     */
+    static bool decode(const QByteArray& data, std::vector<std::vector<Fruit>>& outMap,
+                       int& outMapSize, std::vector<uint32_t>& outRngState);
+};
+
+#endif // BOARDSERIALIZER_H
@@ -2,6 +2,7 @@
 #include "MatchDetector.h"
 #include <chrono>
 #include <algorithm>
+#include <sstream>
 
 FruitGenerator::FruitGenerator() {
     // 使用当前时间作为随机种子
@@ -113,6 +114,48 @@ void FruitGenerator::setSeed(unsigned int seed) {
     rng_.seed(seed);
 }
 
+/**
+ * @brief 导出随机数生成器状态
+ * 
+ * 标准库只提供流格式的引擎状态，这里转成定长整数序列，便于二进制存档
+ */
+std::vector<uint32_t> FruitGenerator::saveRngState() const {
+    std::stringstream ss;
+    ss << rng_;
+    
+    std::vector<uint32_t> state;
+    state.reserve(std::mt19937::state_size + 1);
+    unsigned long word = 0;
+    while (ss >> word) {
+        state.push_back(static_cast<uint32_t>(word));
+    }
+    return state;
+}
+
+/**
+ * @brief 恢复随机数生成器状态
+ */
+bool FruitGenerator::restoreRngState(const std::vector<uint32_t>& state) {
+    if (state.size() < std::mt19937::state_size) {
+        return false;
+    }
+    
+    std::stringstream ss;
+    for (size_t i = 0; i < state.size(); i++) {
+        if (i > 0) ss << ' ';
+        ss << state[i];
+    }
+    
+    std::mt19937 restored;
+    ss >> restored;
+    if (ss.fail()) {
+        return false;
+    }
+    
+    rng_ = restored;
+    return true;
+}
+
 void FruitGenerator::shuffleMap(std::vector<std::vector<Fruit>>& map, MatchDetector& detector, int mapSize) {
     // 收集所有非空水果类型
     std::vector<FruitType> fruits;
@@ -3,6 +3,8 @@
 
 #include "FruitTypes.h"
 #include <random>
+#include <vector>
+#include <cstdint>
 
 /**
  * @brief 水果生成器类
@@ -76,6 +78,19 @@ public:
      */
     void setSeed(unsigned int seed);
     
+    /**
+     * @brief 导出随机数生成器状态（用于存档）
+     * @return 状态字序列
+     */
+    std::vector<uint32_t> saveRngState() const;
+    
+    /**
+     * @brief 恢复随机数生成器状态
+     * @param state saveRngState 导出的状态字序列
+     * @return 是否恢复成功（失败时保持原状态）
+     */
+    bool restoreRngState(const std::vector<uint32_t>& state);
+    
 private:
     std::mt19937 rng_;  // 随机数生成器
     
@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <utility>
+#include <cstdint>
 #include <functional>
 #include <string>
 #include <ctime>
@@ -272,6 +273,29 @@ inline bool isMatchableFruit(FruitType type) {
     return type != FruitType::EMPTY && type != FruitType::CANDY;
 }
 
+/**
+ * @brief 将单元格压缩为 1 字节（低4位水果类型 + 高3位特殊类型）
+ * 用于撤销历史与存档等需要紧凑存储棋盘的场景
+ */
+inline uint8_t packCell(FruitType type, SpecialType special) {
+    return static_cast<uint8_t>((static_cast<int>(type) & 0x0F) |
+                                ((static_cast<int>(special) & 0x07) << 4));
+}
+
+/**
+ * @brief 从压缩字节中取出水果类型
+ */
+inline FruitType unpackCellType(uint8_t packed) {
+    return static_cast<FruitType>(packed & 0x0F);
+}
+
+/**
+ * @brief 从压缩字节中取出特殊类型
+ */
+inline SpecialType unpackCellSpecial(uint8_t packed) {
+    return static_cast<SpecialType>((packed >> 4) & 0x07);
+}
+
 /**
  * @brief 判断是否为有效的地图坐标
  */
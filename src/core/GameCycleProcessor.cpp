@@ -50,6 +50,18 @@ bool GameCycleProcessor::processMatchCycle(std::vector<std::vector<Fruit>>& map,
         if (isFirstMatch) {
             processSpecialGeneration(map, matches, specialPositions);
             isFirstMatch = false;
+            
+            // 记录生成的特殊元素（撤销历史与成就统计使用）
+            for (const auto& pos : specialPositions) {
+                SpecialSpawn spawn;
+                spawn.row = pos.first;
+                spawn.col = pos.second;
+                spawn.special = map[pos.first][pos.second].special;
+                round.elimination.createdSpecials.push_back(spawn);
+                if (eventBus_) {
+                    eventBus_->emitSpecialCreated(currentRound_, spawn.row, spawn.col, spawn.special);
+                }
+            }
         }
         
         // 3. 计算得分
@@ -71,6 +83,9 @@ bool GameCycleProcessor::processMatchCycle(std::vector<std::vector<Fruit>>& map,
             group.count = match.matchCount;
             group.type = match.fruitType;
             round.elimination.matchGroups.push_back(group);
+            if (eventBus_) {
+                eventBus_->emitMatchFormed(currentRound_, group.type, group.count, round.comboCount);
+            }
         }
         
         // 5. 触发特殊元素效果
@@ -83,7 +98,13 @@ bool GameCycleProcessor::processMatchCycle(std::vector<std::vector<Fruit>>& map,
         animRecorder_.recordFallAndRefill(map, fruitGenerator_, round.fall);
         
         // 8. 保存本轮
+        if (eventBus_) {
+            eventBus_->emitRoundResolved(currentRound_, cascadeSource_, score, round.comboCount,
+                                         static_cast<int>(round.elimination.positions.size()),
+                                         round.elimination.types);
+        }
         outRounds.push_back(round);
+        currentRound_++;
         
         // 9. 增加连击
         scoreCalculator_.incrementCombo();
@@ -206,6 +227,9 @@ void GameCycleProcessor::triggerSpecialEffects(std::vector<std::vector<Fruit>>&
     for (int row = 0; row < static_cast<int>(map.size()); row++) {
         for (int col = 0; col < static_cast<int>(map.size()); col++) {
             if (map[row][col].isMatched && map[row][col].special != SpecialType::NONE) {
+                if (eventBus_) {
+                    eventBus_->emitSpecialTriggered(currentRound_, row, col, map[row][col].special);
+                }
                 std::set<std::pair<int, int>> affectedPositions;
                 specialProcessor_.triggerSpecialEffect(map, row, col, affectedPositions);
                 
@@ -289,5 +313,12 @@ bool GameCycleProcessor::processPropElimination(std::vector<std::vector<Fruit>>&
     // 5. 处理下落和填�?
     animRecorder_.recordFallAndRefill(map, fruitGenerator_, outRound.fall);
     
+    if (eventBus_) {
+        eventBus_->emitRoundResolved(currentRound_, RoundSource::PROP, outScore, 0,
+                                     static_cast<int>(outRound.elimination.positions.size()),
+                                     outRound.elimination.types);
+    }
+    currentRound_++;
+    
     return true;
 }
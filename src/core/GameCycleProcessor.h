@@ -8,6 +8,7 @@
 #include "AnimationRecorder.h"
 #include "FruitGenerator.h"
 #include "ScoreCalculator.h"
+#include "GameEventBus.h"
 #include <vector>
 #include <set>
 
@@ -78,6 +79,21 @@ public:
      */
     int getLastMaxCombo() const { return lastMaxCombo_; }
     
+    /**
+     * @brief 设置事件总线（消除流程中内联写入引擎事件）
+     * @param bus 事件总线，nullptr 表示不发送事件
+     */
+    void setEventBus(GameEventBus* bus) { eventBus_ = bus; }
+    
+    /**
+     * @brief 重置轮次序号（每次玩家操作开始时调用，使事件轮次与动画轮次下标一致）
+     * @param source 本次操作中连锁轮次的来源
+     */
+    void resetRoundCounter(RoundSource source = RoundSource::PLAYER_CASCADE) {
+        currentRound_ = 0;
+        cascadeSource_ = source;
+    }
+    
 private:
     /**
      * @brief 处理特殊元素生成
@@ -107,6 +123,9 @@ private:
     ScoreCalculator& scoreCalculator_;
     
     int lastMaxCombo_ = 0;  ///< 上一次循环达到的最大连击数
+    int currentRound_ = 0;  ///< 本次操作内的轮次序号（事件使用）
+    RoundSource cascadeSource_ = RoundSource::PLAYER_CASCADE;  ///< 本次操作中连锁轮次的来源
+    GameEventBus* eventBus_ = nullptr;  ///< 引擎事件总线
 };
 
 #endif // GAMECYCLEPROCESSOR_H
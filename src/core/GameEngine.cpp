@@ -1,6 +1,7 @@
 #include "GameEngine.h"
 #include "AchievementManager.h"
 #include "Database.h"
+#include "PersistenceWorker.h"
 #include <algorithm>
 #include <iostream>
 
@@ -16,6 +17,10 @@ GameEngine::GameEngine()
 {
     // 构造函数 - 初始化成员变量和模块
     lastAnimation_ = GameAnimationSequence{}; // 清零动画记录
+    
+    // 消除流程内联发送事件，会话统计作为订阅者之一
+    cycleProcessor_.setEventBus(&eventBus_);
+    eventBus_.subscribe(this);
 }
 
 GameEngine::~GameEngine() {
@@ -43,6 +48,51 @@ void GameEngine::initializeGame(int initialScore, int mapSize) {
     
     // 4. 清空最近动画记录
     lastAnimation_ = GameAnimationSequence{};
+    
+    // 5. 以新棋盘为基准重置撤销历史
+    moveHistory_.reset(map_, mapSize_);
+}
+
+/**
+ * @brief 从存档恢复棋盘
+ */
+bool GameEngine::restoreGame(const QByteArray& data, int expectedMapSize, int initialScore) {
+    // 1. 解码存档并校验地图大小（全部校验通过前不修改任何状态）
+    std::vector<std::vector<Fruit>> map;
+    int mapSize = 0;
+    std::vector<uint32_t> rngState;
+    if (!BoardSerializer::decode(data, map, mapSize, rngState) || mapSize != expectedMapSize) {
+        return false;
+    }
+    
+    // 2. 恢复随机数状态（保证续玩时新水果序列与存档时一致）
+    if (!fruitGenerator_.restoreRngState(rngState)) {
+        return false;
+    }
+    
+    // 3. 替换地图并重置游戏状态
+    map_.swap(map);
+    mapSize_ = mapSize;
+    state_ = GameState::IDLE;
+    currentScore_ = initialScore;
+    totalMatches_ = 0;
+    scoreCalculator_.resetCombo();
+    lastAnimation_ = GameAnimationSequence{};
+    
+    // 4. 存档理论上总是可玩，防御性检查死局
+    fruitGenerator_.ensurePlayable(map_, matchDetector_, mapSize_);
+    
+    // 5. 以恢复的棋盘为基准重置撤销历史
+    moveHistory_.reset(map_, mapSize_);
+    
+    return true;
+}
+
+/**
+ * @brief 导出当前棋盘存档
+ */
+QByteArray GameEngine::saveBoardState() const {
+    return BoardSerializer::encode(map_, mapSize_, fruitGenerator_.saveRngState());
 }
 
 /**
@@ -51,6 +101,8 @@ void GameEngine::initializeGame(int initialScore, int mapSize) {
 bool GameEngine::swapFruits(int row1, int col1, int row2, int col2) {
     // 清空动画记录
     lastAnimation_ = GameAnimationSequence{};
+    moveHistory_.beginMove(currentScore_, propManager_);
+    cycleProcessor_.resetRoundCounter();
     
     // 1. 使用 SwapHandler 执行交换
     std::vector<GameRound> swapRounds;
@@ -71,6 +123,18 @@ bool GameEngine::swapFruits(int row1, int col1, int row2, int col2) {
         // 记录下落
         animRecorder_.recordFallAndRefill(map_, fruitGenerator_, 
                                            lastAnimation_.rounds.back().fall);
+        
+        // 特殊组合轮次由 SwapHandler 生成，在此补发事件
+        int roundIndex = static_cast<int>(lastAnimation_.rounds.size()) - 1;
+        for (const auto& effect : round.elimination.bombEffects) {
+            // BombEffectType 与 SpecialType 枚举值一一对应
+            eventBus_.emitSpecialTriggered(roundIndex, effect.row, effect.col,
+                                           static_cast<SpecialType>(static_cast<int>(effect.type)));
+        }
+        eventBus_.emitRoundResolved(roundIndex, RoundSource::SPECIAL_COMBO, round.scoreDelta,
+                                    round.comboCount,
+                                    static_cast<int>(round.elimination.positions.size()),
+                                    round.elimination.types);
     }
     
     // 3. 如果是普通交换成功，处理游戏循环
@@ -79,6 +143,12 @@ bool GameEngine::swapFruits(int row1, int col1, int row2, int col2) {
         processGameCycle();
     }
     
+    // 4. 记录撤销增量
+    moveHistory_.commitMove(map_, lastAnimation_, currentScore_, propManager_);
+    
+    // 5. 派发本次操作的事件
+    eventBus_.flush();
+    
     return true;
 }
 
@@ -92,44 +162,9 @@ bool GameEngine::processGameCycle() {
     
     bool hadElimination = cycleProcessor_.processMatchCycle(map_, cycleRounds, totalScore);
     
-    // 追加循环产生的轮次并统计消除数据
+    // 追加循环产生的轮次（消除统计已通过事件总线内联发送）
     for (const auto& round : cycleRounds) {
         lastAnimation_.rounds.push_back(round);
-        
-        // 统计消除数据
-        if (round.elimination.positions.size() > 0) {
-            sessionStats_.totalEliminates++;
-            
-            // 统计消除的水果类型
-            for (size_t i = 0; i < round.elimination.types.size(); ++i) {
-                int typeVal = static_cast<int>(round.elimination.types[i]);
-                if (typeVal > 0) {
-                    sessionStats_.eliminatedFruitTypes.insert(typeVal);
-                }
-            }
-            
-            // 📌 核心修复：遍历每个独立的匹配组，为每个4+消发送成就快照
-            for (const auto& matchGroup : round.elimination.matchGroups) {
-                int matchSize = matchGroup.count;
-                
-                // 统计单局消除次数
-                if (matchSize == 4) sessionStats_.match4Count++;
-                if (matchSize == 5) sessionStats_.match5Count++;
-                if (matchSize >= 6) sessionStats_.match6Count++;
-                
-                // 为每个匹配组发送成就快照
-                GameDataSnapshot snapshot;
-                snapshot.currentScore = currentScore_;
-                snapshot.lastMatchSize = matchSize;
-                snapshot.lastMatchElementType = static_cast<int>(matchGroup.type);
-                snapshot.lastMatchSameElement = true;  // 每个匹配组内部必然是同类型
-                snapshot.currentCombo = scoreCalculator_.getComboCount();
-                snapshot.gameMode = sessionStats_.gameMode;
-                snapshot.gameStartTime = sessionStats_.startTime;
-                
-                AchievementManager::instance().recordGameSnapshot(snapshot);
-            }
-        }
     }
     
     // 更新分数
@@ -194,6 +229,10 @@ bool GameEngine::useProp(ClickMode mode, int row, int col) {
     std::set<std::pair<int, int>> affectedPositions;
     bool success = false;
     
+    // 记录道具扣除前的状态（撤销时一并返还）
+    moveHistory_.beginMove(currentScore_, propManager_);
+    cycleProcessor_.resetRoundCounter(RoundSource::PROP);
+    
     // 根据模式调用对应道具
     switch (mode) {
         case ClickMode::PROP_HAMMER:
@@ -213,6 +252,10 @@ bool GameEngine::useProp(ClickMode mode, int row, int col) {
         return false;
     }
     
+    eventBus_.emitPropUsed(static_cast<int>(mode == ClickMode::PROP_HAMMER ? PropType::HAMMER
+                                                                           : PropType::MAGIC_WAND),
+                           row, col, static_cast<int>(affectedPositions.size()));
+    
     // 初始化动画序列
     lastAnimation_ = GameAnimationSequence();
     lastAnimation_.swap.success = false;  // 道具模式不是交换
@@ -253,7 +296,10 @@ bool GameEngine::useProp(ClickMode mode, int row, int col) {
         }
     }
     
+    moveHistory_.commitMove(map_, lastAnimation_, currentScore_, propManager_);
+    
     state_ = GameState::IDLE;
+    eventBus_.flush();
     return true;
 }
 
@@ -265,11 +311,16 @@ bool GameEngine::useClampProp(int row1, int col1, int row2, int col2) {
         return false;
     }
     
+    moveHistory_.beginMove(currentScore_, propManager_);
+    cycleProcessor_.resetRoundCounter(RoundSource::PROP);
+    
     // 验证夹子是否可用
     if (!propManager_.useClamp(map_, row1, col1, row2, col2)) {
         return false;
     }
     
+    eventBus_.emitPropUsed(static_cast<int>(PropType::CLAMP), row1, col1, 2);
+    
     // 初始化动画序列
     lastAnimation_ = GameAnimationSequence();
     lastAnimation_.swap.row1 = row1;
@@ -309,10 +360,90 @@ bool GameEngine::useClampProp(int row1, int col1, int row2, int col2) {
         }
     }
     
+    moveHistory_.commitMove(map_, lastAnimation_, currentScore_, propManager_);
+    
     state_ = GameState::IDLE;
+    eventBus_.flush();
     return true;
 }
 
+// ==================== 撤销/重做 ====================
+
+/**
+ * @brief 撤销上一步操作
+ */
+bool GameEngine::undoMove() {
+    if (state_ != GameState::IDLE) {
+        return false;
+    }
+    
+    if (!moveHistory_.undo(map_, currentScore_, propManager_)) {
+        return false;
+    }
+    
+    scoreCalculator_.resetCombo();
+    lastAnimation_ = GameAnimationSequence{};
+    return true;
+}
+
+/**
+ * @brief 重做上一步被撤销的操作
+ */
+bool GameEngine::redoMove() {
+    if (state_ != GameState::IDLE) {
+        return false;
+    }
+    
+    if (!moveHistory_.redo(map_, currentScore_, propManager_)) {
+        return false;
+    }
+    
+    scoreCalculator_.resetCombo();
+    lastAnimation_ = GameAnimationSequence{};
+    return true;
+}
+
+// ==================== 引擎事件 ====================
+
+/**
+ * @brief 根据引擎事件更新会话统计
+ */
+void GameEngine::onGameEvents(const GameEvent* events, int count)
+{
+    for (int i = 0; i < count; ++i) {
+        const GameEvent& event = events[i];
+        switch (event.type) {
+            case GameEventType::MATCH_FORMED:
+                if (event.match.count == 4) sessionStats_.match4Count++;
+                if (event.match.count == 5) sessionStats_.match5Count++;
+                if (event.match.count >= 6) sessionStats_.match6Count++;
+                break;
+            case GameEventType::SPECIAL_CREATED:
+                sessionStats_.specialGenerated++;
+                break;
+            case GameEventType::SPECIAL_TRIGGERED:
+                sessionStats_.specialUsed++;
+                break;
+            case GameEventType::ROUND_RESOLVED:
+                // 只统计玩家交换触发的连锁轮次，道具与特殊组合轮次不计入
+                if (event.roundResolved.source == static_cast<uint8_t>(RoundSource::PLAYER_CASCADE) &&
+                    event.roundResolved.eliminated > 0) {
+                    sessionStats_.totalEliminates++;
+                    // 统计消除的水果类型（含炸弹波及的格子，与原统计一致不计 APPLE）
+                    for (int type = 1; type <= static_cast<int>(FruitType::EMPTY); ++type) {
+                        if (event.roundResolved.fruitTypeMask & (1u << type)) {
+                            sessionStats_.eliminatedFruitTypes.insert(type);
+                        }
+                    }
+                }
+                break;
+            case GameEventType::PROP_USED:
+                sessionStats_.propUsed++;
+                break;
+        }
+    }
+}
+
 // ==================== 成就系统集成 ====================
 
 /**
@@ -345,21 +476,34 @@ void GameEngine::endGameSession()
     snapshot.match4Count = sessionStats_.match4Count;
     snapshot.match5Count = sessionStats_.match5Count;
     snapshot.match6Count = sessionStats_.match6Count;
+    snapshot.match5PlusCount = sessionStats_.match5Count + sessionStats_.match6Count;  // match6Count 已含 6 消以上
+    snapshot.match6PlusCount = sessionStats_.match6Count;
     snapshot.fruitTypesEliminated = sessionStats_.eliminatedFruitTypes;
     snapshot.propUsed = (sessionStats_.propUsed > 0);
     
     // 保存数据到数据库（仅非游客模式）
+    // 在主线程取好数据，交给持久化线程在一个事务内写入，不阻塞界面
     QString playerId = Database::instance().getCurrentPlayerId();
     if (sessionStats_.gameMode == "Casual" && playerId != "guest") {
-        Database::instance().savePlayerScore(playerId, currentScore_);
-        Database::instance().savePlayerProps(
-            playerId,
-            propManager_.getPropCount(PropType::HAMMER),
-            propManager_.getPropCount(PropType::CLAMP),
-            propManager_.getPropCount(PropType::MAGIC_WAND)
-        );
+        const int score = currentScore_;
+        const int hammer = propManager_.getPropCount(PropType::HAMMER);
+        const int clamp = propManager_.getPropCount(PropType::CLAMP);
+        const int magicWand = propManager_.getPropCount(PropType::MAGIC_WAND);
+        const QByteArray board = saveBoardState();
+        
+        PersistenceWorker::instance().submit({
+            [playerId, score]() {
+                return Database::instance().savePlayerScore(playerId, score);
+            },
+            [playerId, hammer, clamp, magicWand]() {
+                return Database::instance().savePlayerProps(playerId, hammer, clamp, magicWand);
+            },
+            [playerId, board]() {
+                return Database::instance().saveCasualBoard(playerId, board);
+            }
+        });
     }
     
     // 通知成就系统结束会话
-    AchievementManager::instance().recordGameSession(sessionStats_.gameMode, false);
+    AchievementManager::instance().recordGameSession(sessionStats_.gameMode, false, snapshot);
 }
@@ -11,6 +11,9 @@
 #include "SwapHandler.h"
 #include "AnimationRecorder.h"
 #include "GameCycleProcessor.h"
+#include "MoveHistory.h"
+#include "BoardSerializer.h"
+#include "GameEventBus.h"
 #include "../props/PropManager.h"
 #include <set>
 #include <vector>
@@ -67,6 +70,15 @@ struct MatchGroup {
     FruitType type = FruitType::EMPTY;  ///< 水果类型
 };
 
+/**
+ * @brief 本轮生成的特殊元素信息
+ */
+struct SpecialSpawn {
+    int row = -1;
+    int col = -1;
+    SpecialType special = SpecialType::NONE;  ///< 生成（或升级后）的特殊类型
+};
+
 /**
  * @brief 单轮消除步骤信息
  */
@@ -75,6 +87,7 @@ struct EliminationStep {
     std::vector<FruitType> types;               ///< 对应位置的原始水果类型（用于成就检测）
     std::vector<MatchGroup> matchGroups;        ///< 每个匹配组的独立信息（用于多消成就）
     std::vector<BombEffect> bombEffects;        ///< 本轮触发的炸弹特效列表
+    std::vector<SpecialSpawn> createdSpecials;  ///< 本轮生成的特殊元素（保留在原位，不在 positions 中）
 };
 
 /**
@@ -162,10 +175,10 @@ enum class GameState {
  * 6. 计算得分和连击
  * 7. 检测死局并重排
  */
-class GameEngine {
+class GameEngine : public IGameEventObserver {
 public:
     GameEngine();
-    ~GameEngine();
+    ~GameEngine() override;
     
     /**
      * @brief 初始化游戏（创建地图）
@@ -174,6 +187,20 @@ public:
      */
     void initializeGame(int initialScore = 0, int mapSize = MAP_SIZE);
     
+    /**
+     * @brief 从存档恢复棋盘（休闲模式续玩）
+     * @param data BoardSerializer 编码的棋盘数据
+     * @param expectedMapSize 期望的地图大小（与存档不一致时视为恢复失败）
+     * @param initialScore 初始分数
+     * @return 是否恢复成功（失败时不修改当前游戏）
+     */
+    bool restoreGame(const QByteArray& data, int expectedMapSize, int initialScore = 0);
+    
+    /**
+     * @brief 导出当前棋盘存档（地图、地图大小和随机数状态）
+     */
+    QByteArray saveBoardState() const;
+    
     /**
      * @brief 尝试交换两个水果
      * @param row1 第一个水果的行
@@ -309,6 +336,38 @@ public:
      */
     void setMapSize(int size) { mapSize_ = size; }
     
+    // ==================== 撤销/重做 ====================
+    
+    /**
+     * @brief 撤销上一步操作（交换或道具），恢复棋盘、分数和道具数量
+     * @return 是否撤销成功（动画进行中或无历史时返回false）
+     */
+    bool undoMove();
+    
+    /**
+     * @brief 重做上一步被撤销的操作
+     * @return 是否重做成功
+     */
+    bool redoMove();
+    
+    /**
+     * @brief 获取引擎事件总线（成就、统计、回放等模块在此订阅）
+     */
+    GameEventBus& getEventBus() { return eventBus_; }
+    
+    /**
+     * @brief 事件订阅回调：根据引擎事件更新会话统计
+     */
+    void onGameEvents(const GameEvent* events, int count) override;
+    
+    bool canUndo() const { return state_ == GameState::IDLE && moveHistory_.canUndo(); }
+    bool canRedo() const { return state_ == GameState::IDLE && moveHistory_.canRedo(); }
+    
+    /**
+     * @brief 设置撤销历史深度（0 表示禁用，会清空已有历史）
+     */
+    void setHistoryDepth(int depth) { moveHistory_.setDepth(depth); }
+    
 private:
     // 基础子系统
     FruitGenerator fruitGenerator_;              ///< 水果生成器
@@ -323,6 +382,8 @@ private:
     AnimationRecorder animRecorder_;             ///< 动画记录器
     GameCycleProcessor cycleProcessor_;          ///< 循环处理器
     PropManager propManager_;                    ///< 道具管理器
+    MoveHistory moveHistory_;                    ///< 撤销/重做历史
+    GameEventBus eventBus_;                      ///< 引擎事件总线
     
     // 游戏数据
     std::vector<std::vector<Fruit>> map_;        ///< 游戏地图（大小可配置）
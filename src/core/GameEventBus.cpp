@@ -0,0 +1,93 @@
+#include "GameEventBus.h"
+#include <algorithm>
+
+GameEventBus::GameEventBus(int capacity)
+    : buffer_(capacity > 0 ? capacity : DEFAULT_CAPACITY)
+{
+}
+
+GameEventBus::~GameEventBus() {
+    // 析构函数 - 无需清理（不持有订阅者）
+}
+
+void GameEventBus::subscribe(IGameEventObserver* observer) {
+    if (observer && std::find(observers_.begin(), observers_.end(), observer) == observers_.end()) {
+        observers_.push_back(observer);
+    }
+}
+
+void GameEventBus::unsubscribe(IGameEventObserver* observer) {
+    observers_.erase(std::remove(observers_.begin(), observers_.end(), observer), observers_.end());
+}
+
+/**
+ * @brief 取下一个空闲槽位（缓冲区满时先派发已有事件）
+ */
+GameEvent& GameEventBus::next(GameEventType type, int round) {
+    if (count_ >= static_cast<int>(buffer_.size())) {
+        flush();
+    }
+    
+    GameEvent& event = buffer_[count_++];
+    event.type = type;
+    event.round = static_cast<uint8_t>(std::min(round, 255));
+    return event;
+}
+
+void GameEventBus::emitMatchFormed(int round, FruitType type, int count, int combo) {
+    GameEvent& event = next(GameEventType::MATCH_FORMED, round);
+    event.match.fruitType = static_cast<int8_t>(type);
+    event.match.count = static_cast<uint8_t>(count);
+    event.match.combo = static_cast<uint16_t>(combo);
+}
+
+void GameEventBus::emitSpecialCreated(int round, int row, int col, SpecialType special) {
+    GameEvent& event = next(GameEventType::SPECIAL_CREATED, round);
+    event.special.row = static_cast<int16_t>(row);
+    event.special.col = static_cast<int16_t>(col);
+    event.special.special = static_cast<uint8_t>(special);
+}
+
+void GameEventBus::emitSpecialTriggered(int round, int row, int col, SpecialType special) {
+    GameEvent& event = next(GameEventType::SPECIAL_TRIGGERED, round);
+    event.special.row = static_cast<int16_t>(row);
+    event.special.col = static_cast<int16_t>(col);
+    event.special.special = static_cast<uint8_t>(special);
+}
+
+void GameEventBus::emitRoundResolved(int round, RoundSource source, int scoreDelta, int combo,
+                                     int eliminated, const std::vector<FruitType>& eliminatedTypes) {
+    // 写入事件时把消除类型折叠为位掩码（特殊组合轮次不记录类型，掩码为 0）
+    uint8_t mask = 0;
+    for (FruitType type : eliminatedTypes) {
+        mask |= static_cast<uint8_t>(1u << static_cast<int>(type));
+    }
+    
+    GameEvent& event = next(GameEventType::ROUND_RESOLVED, round);
+    event.roundResolved.scoreDelta = scoreDelta;
+    event.roundResolved.combo = static_cast<uint16_t>(combo);
+    event.roundResolved.eliminated = static_cast<uint16_t>(std::min(eliminated, 0xFFFF));
+    event.roundResolved.source = static_cast<uint8_t>(source);
+    event.roundResolved.fruitTypeMask = mask;
+}
+
+void GameEventBus::emitPropUsed(int prop, int row, int col, int affected) {
+    GameEvent& event = next(GameEventType::PROP_USED, 0);
+    event.prop.prop = static_cast<uint8_t>(prop);
+    event.prop.row = static_cast<int16_t>(row);
+    event.prop.col = static_cast<int16_t>(col);
+    event.prop.affected = static_cast<uint16_t>(std::min(affected, 0xFFFF));
+}
+
+void GameEventBus::flush() {
+    if (count_ == 0) {
+        return;
+    }
+    
+    // 订阅者在回调中不应写入新事件
+    const int count = count_;
+    count_ = 0;
+    for (IGameEventObserver* observer : observers_) {
+        observer->onGameEvents(buffer_.data(), count);
+    }
+}
@@ -0,0 +1,136 @@
+#ifndef GAMEEVENTBUS_H
+#define GAMEEVENTBUS_H
+
+#include "FruitTypes.h"
+#include <vector>
+#include <cstdint>
+
+/**
+ * @brief 引擎事件类型
+ */
+enum class GameEventType : uint8_t {
+    MATCH_FORMED,       ///< 形成一个匹配组
+    SPECIAL_CREATED,    ///< 生成特殊元素
+    SPECIAL_TRIGGERED,  ///< 特殊元素被引爆
+    ROUND_RESOLVED,     ///< 一轮消除+下落结算完成
+    PROP_USED           ///< 使用道具
+};
+
+/**
+ * @brief 轮次来源（会话统计只计入玩家交换触发的连锁轮次）
+ */
+enum class RoundSource : uint8_t {
+    PLAYER_CASCADE,     ///< 玩家交换后的连锁轮次
+    SPECIAL_COMBO,      ///< 特殊元素组合交换轮次
+    PROP                ///< 道具消除及其后续连锁轮次
+};
+
+/**
+ * @brief 匹配组事件数据
+ */
+struct MatchFormedData {
+    int8_t fruitType;   ///< FruitType
+    uint8_t count;      ///< 匹配数量（3、4、5...）
+    uint16_t combo;     ///< 当前连击数
+};
+
+/**
+ * @brief 特殊元素生成/引爆事件数据
+ */
+struct SpecialData {
+    int16_t row;
+    int16_t col;
+    uint8_t special;    ///< SpecialType
+};
+
+/**
+ * @brief 轮次结算事件数据
+ */
+struct RoundResolvedData {
+    int32_t scoreDelta;     ///< 本轮得分
+    uint16_t combo;         ///< 本轮连击数
+    uint16_t eliminated;    ///< 本轮消除格数
+    uint8_t source;         ///< RoundSource
+    uint8_t fruitTypeMask;  ///< 本轮消除的水果类型位掩码（第 n 位对应 FruitType 值 n）
+};
+
+/**
+ * @brief 道具使用事件数据
+ */
+struct PropUsedData {
+    uint8_t prop;           ///< PropType
+    int16_t row;
+    int16_t col;
+    uint16_t affected;      ///< 道具直接影响的格数
+};
+
+/**
+ * @brief 引擎事件（POD，按类型读取对应的 union 成员）
+ */
+struct GameEvent {
+    GameEventType type;
+    uint8_t round;          ///< 本次操作内的轮次序号（与 GameAnimationSequence::rounds 下标一致）
+    union {
+        MatchFormedData match;
+        SpecialData special;
+        RoundResolvedData roundResolved;
+        PropUsedData prop;
+    };
+};
+
+/**
+ * @brief 引擎事件观察者接口
+ */
+class IGameEventObserver {
+public:
+    virtual ~IGameEventObserver() = default;
+    
+    /**
+     * @brief 接收一批事件（数据直接指向事件缓冲区，回调返回后失效）
+     * @param events 事件数组
+     * @param count 事件数量
+     */
+    virtual void onGameEvents(const GameEvent* events, int count) = 0;
+};
+
+/**
+ * @brief 引擎事件总线
+ * 
+ * 职责：
+ * 1. 引擎在消除流程中内联写入事件（预分配缓冲区，不产生额外分配）
+ * 2. 每次玩家操作结束时统一派发给所有订阅者
+ * 3. 缓冲区写满时提前派发，保证长连锁也不会扩容
+ */
+class GameEventBus {
+public:
+    static constexpr int DEFAULT_CAPACITY = 512;  ///< 默认缓冲区容量（事件数）
+    
+    explicit GameEventBus(int capacity = DEFAULT_CAPACITY);
+    ~GameEventBus();
+    
+    void subscribe(IGameEventObserver* observer);
+    void unsubscribe(IGameEventObserver* observer);
+    
+    void emitMatchFormed(int round, FruitType type, int count, int combo);
+    void emitSpecialCreated(int round, int row, int col, SpecialType special);
+    void emitSpecialTriggered(int round, int row, int col, SpecialType special);
+    void emitRoundResolved(int round, RoundSource source, int scoreDelta, int combo,
+                           int eliminated, const std::vector<FruitType>& eliminatedTypes);
+    void emitPropUsed(int prop, int row, int col, int affected);
+    
+    /**
+     * @brief 派发缓冲区内的所有事件并清空
+     */
+    void flush();
+    
+    int pendingCount() const { return count_; }
+    
+private:
+    GameEvent& next(GameEventType type, int round);
+    
+    std::vector<GameEvent> buffer_;                 ///< 预分配事件缓冲区
+    int count_ = 0;                                 ///< 已写入事件数
+    std::vector<IGameEventObserver*> observers_;    ///< 订阅者列表
+};
+
+#endif // GAMEEVENTBUS_H
@@ -0,0 +1,212 @@
+#include "MoveHistory.h"
+#include "GameEngine.h"
+#include "../props/PropManager.h"
+#include <algorithm>
+
+namespace {
+const PropType kPropTypes[3] = { PropType::HAMMER, PropType::CLAMP, PropType::MAGIC_WAND };
+}
+
+MoveHistory::MoveHistory(int depth) {
+    setDepth(depth);
+}
+
+MoveHistory::~MoveHistory() {
+    // 析构函数 - 无需清理
+}
+
+void MoveHistory::setDepth(int depth) {
+    slots_.assign(depth > 0 ? depth : 0, MoveDelta{});
+    clear();
+}
+
+void MoveHistory::reset(const std::vector<std::vector<Fruit>>& map, int mapSize) {
+    mapSize_ = mapSize;
+    shadow_.assign(mapSize * mapSize, packCell(FruitType::EMPTY, SpecialType::NONE));
+    stamp_.assign(mapSize * mapSize, 0);
+    epoch_ = 0;
+    
+    for (int row = 0; row < mapSize; row++) {
+        for (int col = 0; col < mapSize; col++) {
+            shadow_[row * mapSize + col] = packCell(map[row][col].type, map[row][col].special);
+        }
+    }
+    
+    clear();
+}
+
+void MoveHistory::clear() {
+    start_ = 0;
+    size_ = 0;
+    cursor_ = 0;
+    pending_ = false;
+}
+
+void MoveHistory::beginMove(int score, const PropManager& props) {
+    pendingScore_ = score;
+    for (int i = 0; i < 3; i++) {
+        pendingProps_[i] = props.getPropCount(kPropTypes[i]);
+    }
+    pending_ = true;
+}
+
+/**
+ * @brief 记录一次操作
+ * 
+ * 实现逻辑：
+ * 1. 从动画记录收集可能变化的格子（交换、消除、生成特殊元素、下落、新水果）
+ * 2. 与影子棋盘比对，只保留真正变化的格子，同时更新影子棋盘
+ * 3. 截断重做分支，写入环形缓冲（满时覆盖最旧记录）
+ */
+void MoveHistory::commitMove(const std::vector<std::vector<Fruit>>& map,
+                             const GameAnimationSequence& sequence,
+                             int score, const PropManager& props) {
+    if (!pending_ || shadow_.empty()) {
+        return;
+    }
+    pending_ = false;
+    
+    // 1. 选择写入槽位（缓冲已满时覆盖最旧记录；深度为0时仅同步影子棋盘）
+    const int capacity = static_cast<int>(slots_.size());
+    MoveDelta scratch;
+    MoveDelta& delta = capacity == 0 ? scratch
+                                     : slots_[cursor_ < capacity ? (start_ + cursor_) % capacity : start_];
+    delta.cells.clear();
+    
+    // 2. 收集变化格子
+    if (++epoch_ == 0) {
+        std::fill(stamp_.begin(), stamp_.end(), 0);
+        epoch_ = 1;
+    }
+    
+    if (sequence.shuffled) {
+        // 重排会改变整盘，退化为全盘比对
+        for (int row = 0; row < mapSize_; row++) {
+            for (int col = 0; col < mapSize_; col++) {
+                collectCell(map, row, col, delta);
+            }
+        }
+    } else {
+        if (sequence.swap.row1 >= 0) {
+            collectCell(map, sequence.swap.row1, sequence.swap.col1, delta);
+            collectCell(map, sequence.swap.row2, sequence.swap.col2, delta);
+        }
+        for (const auto& round : sequence.rounds) {
+            for (const auto& pos : round.elimination.positions) {
+                collectCell(map, pos.first, pos.second, delta);
+            }
+            for (const auto& spawn : round.elimination.createdSpecials) {
+                collectCell(map, spawn.row, spawn.col, delta);
+            }
+            for (const auto& move : round.fall.moves) {
+                collectCell(map, move.fromRow, move.fromCol, delta);
+                collectCell(map, move.toRow, move.toCol, delta);
+            }
+            for (const auto& fruit : round.fall.newFruits) {
+                collectCell(map, fruit.row, fruit.col, delta);
+            }
+        }
+    }
+    
+    if (capacity == 0) {
+        return;
+    }
+    
+    delta.scoreDelta = score - pendingScore_;
+    for (int i = 0; i < 3; i++) {
+        delta.propDelta[i] = props.getPropCount(kPropTypes[i]) - pendingProps_[i];
+    }
+    
+    // 3. 写入环形缓冲（截断重做分支）
+    size_ = cursor_;
+    if (size_ == capacity) {
+        // 缓冲已满：delta 写在最旧槽位上，起点后移
+        start_ = (start_ + 1) % capacity;
+    } else {
+        size_++;
+    }
+    cursor_ = size_;
+}
+
+bool MoveHistory::undo(std::vector<std::vector<Fruit>>& map, int& score, PropManager& props) {
+    if (!canUndo()) {
+        return false;
+    }
+    
+    cursor_--;
+    const MoveDelta& delta = slots_[(start_ + cursor_) % slots_.size()];
+    applyDelta(map, delta, false);
+    
+    score -= delta.scoreDelta;
+    if (score < 0) {
+        score = 0;
+    }
+    for (int i = 0; i < 3; i++) {
+        int count = props.getPropCount(kPropTypes[i]) - delta.propDelta[i];
+        props.setPropCount(kPropTypes[i], count < 0 ? 0 : count);
+    }
+    pending_ = false;
+    return true;
+}
+
+bool MoveHistory::redo(std::vector<std::vector<Fruit>>& map, int& score, PropManager& props) {
+    if (!canRedo()) {
+        return false;
+    }
+    
+    const MoveDelta& delta = slots_[(start_ + cursor_) % slots_.size()];
+    cursor_++;
+    applyDelta(map, delta, true);
+    
+    score += delta.scoreDelta;
+    if (score < 0) {
+        score = 0;
+    }
+    for (int i = 0; i < 3; i++) {
+        int count = props.getPropCount(kPropTypes[i]) + delta.propDelta[i];
+        props.setPropCount(kPropTypes[i], count < 0 ? 0 : count);
+    }
+    pending_ = false;
+    return true;
+}
+
+void MoveHistory::collectCell(const std::vector<std::vector<Fruit>>& map, int row, int col, MoveDelta& delta) {
+    if (row < 0 || row >= mapSize_ || col < 0 || col >= mapSize_) {
+        return;
+    }
+    
+    const int index = row * mapSize_ + col;
+    if (stamp_[index] == epoch_) {
+        return;  // 本次已比对过
+    }
+    stamp_[index] = epoch_;
+    
+    const uint8_t after = packCell(map[row][col].type, map[row][col].special);
+    if (after != shadow_[index]) {
+        CellDelta cell;
+        cell.index = static_cast<uint16_t>(index);
+        cell.before = shadow_[index];
+        cell.after = after;
+        delta.cells.push_back(cell);
+        shadow_[index] = after;
+    }
+}
+
+void MoveHistory::applyDelta(std::vector<std::vector<Fruit>>& map, const MoveDelta& delta, bool forward) {
+    for (const auto& cell : delta.cells) {
+        const int row = cell.index / mapSize_;
+        const int col = cell.index % mapSize_;
+        const uint8_t packed = forward ? cell.after : cell.before;
+        
+        Fruit& fruit = map[row][col];
+        fruit.type = unpackCellType(packed);
+        fruit.special = unpackCellSpecial(packed);
+        fruit.row = row;
+        fruit.col = col;
+        fruit.isMatched = false;
+        fruit.isMoving = false;
+        fruit.animationProgress = 0.0f;
+        
+        shadow_[cell.index] = packed;
+    }
+}
@@ -0,0 +1,122 @@
+#ifndef MOVEHISTORY_H
+#define MOVEHISTORY_H
+
+#include "FruitTypes.h"
+#include <vector>
+#include <cstdint>
+
+// 前向声明
+struct GameAnimationSequence;
+class PropManager;
+
+/**
+ * @brief 单元格变化记录（打包格式见 packCell）
+ */
+struct CellDelta {
+    uint16_t index = 0;   ///< 线性下标 row * mapSize + col
+    uint8_t before = 0;   ///< 操作前的打包单元格
+    uint8_t after = 0;    ///< 操作后的打包单元格
+};
+
+/**
+ * @brief 一次玩家操作（交换/道具）产生的棋盘增量
+ */
+struct MoveDelta {
+    std::vector<CellDelta> cells;  ///< 发生变化的单元格（仅记录变化部分）
+    int scoreDelta = 0;            ///< 本次操作的分数变化
+    int propDelta[3] = {0, 0, 0};  ///< 道具数量变化（锤子、夹子、魔法棒）
+};
+
+/**
+ * @brief 撤销/重做历史 - 基于紧凑棋盘增量的环形缓冲
+ * 
+ * 功能：
+ * 1. 维护一份打包影子棋盘（每格1字节），仅在初始化时整盘构建
+ * 2. 每次操作根据动画记录中涉及的格子与影子棋盘比对，只记录变化格子
+ * 3. 环形缓冲保存最近 depth 步，超出时覆盖最旧记录，槽位内存复用
+ * 4. 分数与道具按差值记录，不会覆盖操作之外的奖励和购买
+ */
+class MoveHistory {
+public:
+    static constexpr int DEFAULT_DEPTH = 64;  ///< 默认历史深度
+    
+    explicit MoveHistory(int depth = DEFAULT_DEPTH);
+    ~MoveHistory();
+    
+    /**
+     * @brief 设置历史深度（会清空已有历史）
+     * @param depth 最多保存的步数，0 表示禁用撤销
+     */
+    void setDepth(int depth);
+    int getDepth() const { return static_cast<int>(slots_.size()); }
+    
+    /**
+     * @brief 以当前棋盘为基准重置历史（新开局时调用）
+     * @param map 游戏地图
+     * @param mapSize 地图大小
+     */
+    void reset(const std::vector<std::vector<Fruit>>& map, int mapSize);
+    
+    /**
+     * @brief 清空撤销/重做记录（保留影子棋盘）
+     */
+    void clear();
+    
+    /**
+     * @brief 操作开始前记录分数与道具数量
+     */
+    void beginMove(int score, const PropManager& props);
+    
+    /**
+     * @brief 操作完成后记录增量
+     * @param map 操作后的游戏地图
+     * @param sequence 本次操作的动画记录（用于定位变化格子）
+     * @param score 操作后的分数
+     * @param props 操作后的道具管理器
+     */
+    void commitMove(const std::vector<std::vector<Fruit>>& map,
+                    const GameAnimationSequence& sequence,
+                    int score, const PropManager& props);
+    
+    bool canUndo() const { return cursor_ > 0; }
+    bool canRedo() const { return cursor_ < size_; }
+    
+    /**
+     * @brief 撤销一步
+     * @return 是否撤销成功
+     */
+    bool undo(std::vector<std::vector<Fruit>>& map, int& score, PropManager& props);
+    
+    /**
+     * @brief 重做一步
+     * @return 是否重做成功
+     */
+    bool redo(std::vector<std::vector<Fruit>>& map, int& score, PropManager& props);
+    
+private:
+    /**
+     * @brief 比对单个格子，若与影子棋盘不同则写入增量
+     */
+    void collectCell(const std::vector<std::vector<Fruit>>& map, int row, int col, MoveDelta& delta);
+    
+    /**
+     * @brief 把增量的 before/after 写回地图和影子棋盘
+     */
+    void applyDelta(std::vector<std::vector<Fruit>>& map, const MoveDelta& delta, bool forward);
+    
+    std::vector<MoveDelta> slots_;   ///< 环形缓冲槽位（容量即深度）
+    int start_ = 0;                  ///< 最旧记录所在槽位
+    int size_ = 0;                   ///< 当前保存的记录数
+    int cursor_ = 0;                 ///< 已应用的记录数（cursor_ < size_ 时可重做）
+    
+    std::vector<uint8_t> shadow_;    ///< 打包影子棋盘（最近一次记录后的状态）
+    std::vector<uint32_t> stamp_;    ///< 格子去重标记
+    uint32_t epoch_ = 0;             ///< 当前去重轮次
+    int mapSize_ = 0;
+    
+    bool pending_ = false;           ///< 是否已调用 beginMove
+    int pendingScore_ = 0;
+    int pendingProps_[3] = {0, 0, 0};
+};
+
+#endif // MOVEHISTORY_H
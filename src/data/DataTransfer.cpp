@@ -0,0 +1,432 @@
+#include "DataTransfer.h"
+#include "Database.h"
+#include "RankManager.h"
+#include "PersistenceWorker.h"
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QVariant>
+#include <QElapsedTimer>
+#include <QDebug>
+#include <memory>
+
+namespace {
+
+/**
+ * @brief 导出表定义（列顺序即文件中的列顺序）
+ */
+struct TableSpec {
+    const char* table;
+    const char* insertVerb;         // 导入时使用的 INSERT 形式
+    int columnCount;
+    const char* columns[8];
+    bool text[8];                   // 列是否为文本（否则为整数）
+    bool importKey[8];              // 导入去重键列（全为 false 表示直接写入目标表）
+};
+
+const TableSpec kTables[] = {
+    { "players", "INSERT OR REPLACE", 8,
+      { "player_id", "username", "total_points", "hammer_count", "clamp_count", "magic_wand_count",
+        "created_at", "last_login" },
+      { true, true, false, false, false, false, true, true },
+      {} },
+    { "achievement_progress", "INSERT OR REPLACE", 6,
+      { "player_id", "achievement_id", "current_value", "target_value", "state", "completed_at" },
+      { true, true, false, false, false, true },
+      {} },
+    { "game_records", "INSERT", 5,
+      { "player_id", "mode", "score", "max_combo", "played_at" },
+      { true, true, false, false, true },
+      { true, true, true, true, true } },
+    { "competition_records", "INSERT", 6,
+      { "player_id", "player_name", "score", "max_combo", "duration_type", "played_at" },
+      { true, true, false, false, true, true },
+      { true, false, true, true, true, true } },
+};
+
+const int TABLE_COUNT = sizeof(kTables) / sizeof(kTables[0]);
+
+const char* const FORMAT_NAME = "fruitcrush-ndjson";
+
+QString columnList(const TableSpec& spec)
+{
+    QString list;
+    for (int i = 0; i < spec.columnCount; ++i) {
+        if (i > 0) list += ", ";
+        list += spec.columns[i];
+    }
+    return list;
+}
+
+bool hasImportKey(const TableSpec& spec)
+{
+    for (int i = 0; i < spec.columnCount; ++i) {
+        if (spec.importKey[i]) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief 导入时写入的表（有去重键的表先写入临时暂存表）
+ */
+QString importTarget(const TableSpec& spec)
+{
+    return hasImportKey(spec) ? QString("temp.import_") + spec.table : QString(spec.table);
+}
+
+/**
+ * @brief 生成暂存表合并语句：目标表中已有相同去重键的行跳过
+ *
+ * 文件内部键相同的多行都会保留（SQLite 会先物化 SELECT 结果，不受本语句新插入行影响），
+ * 因此只去掉与已有数据重复的记录，重复导入同一文件不会产生重复行。
+ */
+QString buildMerge(const TableSpec& spec)
+{
+    QString keyMatch;
+    for (int i = 0; i < spec.columnCount; ++i) {
+        if (!spec.importKey[i]) continue;
+        if (!keyMatch.isEmpty()) keyMatch += " AND ";
+        keyMatch += QString("t.%1 IS s.%1").arg(spec.columns[i]);
+    }
+
+    const QString columns = columnList(spec);
+    return QString("INSERT INTO %1 (%2) SELECT %2 FROM %3 AS s "
+                   "WHERE NOT EXISTS (SELECT 1 FROM %1 AS t WHERE %4)")
+        .arg(QString(spec.table), columns, importTarget(spec), keyMatch);
+}
+
+/**
+ * @brief 生成 rows 行的多行 INSERT 语句
+ */
+QString buildInsert(const TableSpec& spec, int rows)
+{
+    QString placeholders = "(";
+    for (int i = 0; i < spec.columnCount; ++i) {
+        placeholders += (i == 0) ? "?" : ", ?";
+    }
+    placeholders += ")";
+
+    QString sql = QString(spec.insertVerb) + " INTO " + importTarget(spec) + " (" + columnList(spec) + ") VALUES ";
+    for (int i = 0; i < rows; ++i) {
+        if (i > 0) sql += ", ";
+        sql += placeholders;
+    }
+    return sql;
+}
+
+/**
+ * @brief 追加 JSON 字符串字面量
+ */
+void appendJsonString(QByteArray& out, const QString& value)
+{
+    const QByteArray utf8 = value.toUtf8();
+    out += '"';
+    for (char c : utf8) {
+        switch (c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    out += QByteArray("\\u00") + QByteArray::number(static_cast<int>(c), 16).rightJustified(2, '0');
+                } else {
+                    out += c;
+                }
+        }
+    }
+    out += '"';
+}
+
+/**
+ * @brief 导入时某张表的待写缓冲
+ */
+struct PendingRows {
+    const TableSpec* spec = nullptr;
+    QVariantList values;            // 按行展开的列值
+    int rows = 0;
+    std::unique_ptr<QSqlQuery> fullBatch;  // ROWS_PER_INSERT 行的预编译语句
+};
+
+bool flushRows(QSqlDatabase& db, PendingRows& pending)
+{
+    if (pending.rows == 0) {
+        return true;
+    }
+
+    // 满批次复用预编译语句，尾批次单独 prepare
+    QSqlQuery partial(db);
+    QSqlQuery* query = &partial;
+    if (pending.rows == DataTransfer::ROWS_PER_INSERT) {
+        if (!pending.fullBatch) {
+            pending.fullBatch.reset(new QSqlQuery(db));
+            pending.fullBatch->prepare(buildInsert(*pending.spec, pending.rows));
+        }
+        query = pending.fullBatch.get();
+    } else {
+        partial.prepare(buildInsert(*pending.spec, pending.rows));
+    }
+
+    for (const QVariant& value : pending.values) {
+        query->addBindValue(value);
+    }
+
+    if (!query->exec()) {
+        qCritical() << "Failed to import into" << pending.spec->table << ":" << query->lastError().text();
+        return false;
+    }
+
+    pending.values.clear();
+    pending.rows = 0;
+    return true;
+}
+
+} // namespace
+
+/**
+ * @brief 导出四张表到 NDJSON 文件
+ */
+bool DataTransfer::exportToFile(const QString& path, qint64* rowCount)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCritical() << "Failed to open export file:" << path << file.errorString();
+        return false;
+    }
+
+    // 排队中的写入先落盘，再在一个读事务内导出（各表为同一快照）
+    PersistenceWorker::instance().waitForPending();
+    QSqlDatabase db = Database::instance().connection();
+    if (!db.transaction()) {
+        qCritical() << "Failed to begin export transaction:" << db.lastError().text();
+        return false;
+    }
+
+    QByteArray buffer;
+    buffer.reserve(CHUNK_BYTES + 4096);
+    buffer += QByteArray("{\"format\":\"") + FORMAT_NAME + "\",\"version\":"
+            + QByteArray::number(FORMAT_VERSION) + "}\n";
+
+    qint64 total = 0;
+    for (const TableSpec& spec : kTables) {
+        QSqlQuery query(db);
+        query.setForwardOnly(true);
+        if (!query.exec("SELECT " + columnList(spec) + " FROM " + spec.table)) {
+            qCritical() << "Failed to read" << spec.table << ":" << query.lastError().text();
+            db.rollback();
+            return false;
+        }
+
+        const QByteArray linePrefix = QByteArray("{\"t\":\"") + spec.table + "\",\"r\":[";
+        while (query.next()) {
+            buffer += linePrefix;
+            for (int i = 0; i < spec.columnCount; ++i) {
+                if (i > 0) buffer += ',';
+                const QVariant value = query.value(i);
+                if (value.isNull()) {
+                    buffer += "null";
+                } else if (spec.text[i]) {
+                    appendJsonString(buffer, value.toString());
+                } else {
+                    buffer += QByteArray::number(value.toLongLong());
+                }
+            }
+            buffer += "]}\n";
+            ++total;
+
+            // 分块写出，缓冲区保留容量
+            if (buffer.size() >= CHUNK_BYTES) {
+                if (file.write(buffer) != buffer.size()) {
+                    qCritical() << "Failed to write export file:" << file.errorString();
+                    db.rollback();
+                    return false;
+                }
+                buffer.resize(0);
+            }
+        }
+    }
+    if (!db.commit()) {
+        qCritical() << "Failed to finish export transaction:" << db.lastError().text();
+        db.rollback();
+        return false;
+    }
+
+    if (file.write(buffer) != buffer.size()) {
+        qCritical() << "Failed to write export file:" << file.errorString();
+        return false;
+    }
+    file.close();
+
+    if (rowCount) {
+        *rowCount = total;
+    }
+    qDebug() << "Exported" << total << "rows to" << path << "in" << timer.elapsed() << "ms";
+    return true;
+}
+
+/**
+ * @brief 从 NDJSON 文件导入（单事务，失败整体回滚）
+ */
+bool DataTransfer::importFromFile(const QString& path, qint64* rowCount)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCritical() << "Failed to open import file:" << path << file.errorString();
+        return false;
+    }
+
+    // 1. 校验文件头
+    const QJsonObject header = QJsonDocument::fromJson(file.readLine()).object();
+    if (header.value("format").toString() != FORMAT_NAME
+        || header.value("version").toInt() != FORMAT_VERSION) {
+        qCritical() << "Unsupported import file format:" << path;
+        return false;
+    }
+
+    PersistenceWorker::instance().waitForPending();
+    QSqlDatabase db = Database::instance().connection();
+    if (!db.transaction()) {
+        qCritical() << "Failed to begin import transaction:" << db.lastError().text();
+        return false;
+    }
+
+    auto fail = [&db]() {
+        db.rollback();  // 索引删除也在事务内，回滚即恢复
+        return false;
+    };
+
+    // 2. 暂时删除二级索引（加载完再建，避免逐行维护 B 树）
+    //    唯一索引保留：INSERT OR REPLACE 依赖它判定冲突
+    QList<QPair<QString, QString>> deferredIndexes;  // (名称, 建索引语句)
+    QSqlQuery query(db);
+    if (!query.exec(R"(
+        SELECT name, sql FROM sqlite_master
+        WHERE type = 'index' AND sql IS NOT NULL
+          AND sql NOT LIKE 'CREATE UNIQUE INDEX%'
+          AND tbl_name IN ('players', 'achievement_progress', 'game_records', 'competition_records')
+    )")) {
+        qCritical() << "Failed to list indexes:" << query.lastError().text();
+        return fail();
+    }
+    while (query.next()) {
+        deferredIndexes.append(qMakePair(query.value(0).toString(), query.value(1).toString()));
+    }
+    for (const auto& index : deferredIndexes) {
+        if (!query.exec(QString("DROP INDEX %1").arg(index.first))) {
+            qCritical() << "Failed to drop index" << index.first << ":" << query.lastError().text();
+            return fail();
+        }
+    }
+
+    //    有去重键的表先写入空的临时暂存表（随事务回滚）
+    for (const TableSpec& spec : kTables) {
+        if (!hasImportKey(spec)) continue;
+        if (!query.exec(QString("DROP TABLE IF EXISTS %1").arg(importTarget(spec)))
+            || !query.exec(QString("CREATE TEMP TABLE import_%1 AS SELECT %2 FROM %1 WHERE 0")
+                               .arg(QString(spec.table), columnList(spec)))) {
+            qCritical() << "Failed to create staging table for" << spec.table << ":" << query.lastError().text();
+            return fail();
+        }
+    }
+
+    // 3. 逐行读取，按表攒满 ROWS_PER_INSERT 行写一次
+    PendingRows pending[TABLE_COUNT];
+    for (int i = 0; i < TABLE_COUNT; ++i) {
+        pending[i].spec = &kTables[i];
+        pending[i].values.reserve(ROWS_PER_INSERT * kTables[i].columnCount);
+    }
+
+    qint64 total = 0;
+    qint64 lineNumber = 1;
+    while (!file.atEnd()) {
+        const QByteArray line = file.readLine();
+        ++lineNumber;
+        if (line.trimmed().isEmpty()) {
+            continue;
+        }
+
+        const QJsonObject object = QJsonDocument::fromJson(line).object();
+        const QString table = object.value("t").toString();
+        const QJsonArray row = object.value("r").toArray();
+
+        int tableIndex = 0;
+        while (tableIndex < TABLE_COUNT && table != kTables[tableIndex].table) {
+            ++tableIndex;
+        }
+        if (tableIndex == TABLE_COUNT || row.size() != kTables[tableIndex].columnCount) {
+            qCritical() << "Malformed import line" << lineNumber << "in" << path;
+            return fail();
+        }
+
+        PendingRows& rows = pending[tableIndex];
+        for (int i = 0; i < row.size(); ++i) {
+            const QJsonValue value = row.at(i);
+            if (value.isNull()) {
+                rows.values.append(QVariant());
+            } else if (rows.spec->text[i]) {
+                rows.values.append(value.toString());
+            } else {
+                rows.values.append(value.toInteger());
+            }
+        }
+        ++total;
+
+        if (++rows.rows == ROWS_PER_INSERT && !flushRows(db, rows)) {
+            return fail();
+        }
+    }
+
+    for (auto& rows : pending) {
+        if (!flushRows(db, rows)) {
+            return fail();
+        }
+        rows.fullBatch.reset();
+    }
+
+    // 4. 重建索引，再按去重键把暂存表合并进历史表（NOT EXISTS 走刚建好的分页索引）
+    for (const auto& index : deferredIndexes) {
+        if (!query.exec(index.second)) {
+            qCritical() << "Failed to recreate index" << index.first << ":" << query.lastError().text();
+            return fail();
+        }
+    }
+
+    for (const TableSpec& spec : kTables) {
+        if (!hasImportKey(spec)) continue;
+        if (!query.exec(buildMerge(spec))
+            || !query.exec(QString("DROP TABLE %1").arg(importTarget(spec)))) {
+            qCritical() << "Failed to merge imported" << spec.table << ":" << query.lastError().text();
+            return fail();
+        }
+    }
+
+    // 5. 重建排行榜汇总表
+
+    if (!Database::instance().rebuildCompetitionAggregates()) {
+        return fail();
+    }
+
+    if (!db.commit()) {
+        qCritical() << "Failed to commit import:" << db.lastError().text();
+        return fail();
+    }
+
+    RankManager::instance().invalidateLeaderboardCache();
+
+    if (rowCount) {
+        *rowCount = total;
+    }
+    qDebug() << "Imported" << total << "rows from" << path << "in" << timer.elapsed() << "ms";
+    return true;
+}
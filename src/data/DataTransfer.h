@@ -0,0 +1,44 @@
+#ifndef DATATRANSFER_H
+#define DATATRANSFER_H
+
+#include <QString>
+
+/**
+ * @brief 玩家数据导出/导入（NDJSON，流式处理）
+ *
+ * 覆盖 players、achievement_progress、game_records、competition_records 四张表。
+ * 文件格式（每行一个 JSON 对象）：
+ * - 第一行：{"format":"fruitcrush-ndjson","version":1}
+ * - 其余行：{"t":"<表名>","r":[列值...]}，列顺序见 DataTransfer.cpp 中的表定义
+ *
+ * 导出：单个读事务内逐行读取，按 CHUNK_BYTES 分块写文件，内存占用与数据量无关。
+ * 导入：一个大事务；先删除二级索引，多行 INSERT 批量写入，最后重建索引与排行榜汇总表。
+ * players / achievement_progress 以导入数据为准（INSERT OR REPLACE）；
+ * 历史记录先写入临时暂存表，再按导入键（玩家、结束时间、模式/时长、分数、连击）
+ * 跳过目标表中已有的记录后追加，重复导入同一文件或导回源数据库不会产生重复记录。
+ * 导入键只用于导入去重，不是表约束，游戏中正常写入的记录不受影响。
+ */
+class DataTransfer {
+public:
+    static constexpr int FORMAT_VERSION = 1;
+    static constexpr int CHUNK_BYTES = 1 << 20;     ///< 导出写缓冲大小
+    static constexpr int ROWS_PER_INSERT = 100;     ///< 每条 INSERT 的行数（列数 ≤ 8，绑定参数 ≤ 800）
+
+    /**
+     * @brief 导出到文件
+     * @param path 目标文件路径（覆盖）
+     * @param rowCount 输出导出的总行数（可为空）
+     * @return 是否成功
+     */
+    static bool exportToFile(const QString& path, qint64* rowCount = nullptr);
+
+    /**
+     * @brief 从文件导入（全部成功才提交）
+     * @param path 源文件路径
+     * @param rowCount 输出导入的总行数（可为空）
+     * @return 是否成功
+     */
+    static bool importFromFile(const QString& path, qint64* rowCount = nullptr);
+};
+
+#endif // DATATRANSFER_H
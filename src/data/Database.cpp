@@ -5,6 +5,11 @@
 #include <QDebug>
 #include <QVariant>
 #include <QFile>
+#include <QThread>
+#include <QElapsedTimer>
+#include <QMutexLocker>
+#include <QCoreApplication>
+#include <limits>
 
 // 单例实例
 Database& Database::instance()
@@ -28,11 +33,14 @@ Database::~Database()
  */
 bool Database::initialize(const QString& dbPath)
 {
-    db_ = QSqlDatabase::addDatabase("QSQLITE");
-    db_.setDatabaseName(dbPath);
+    QElapsedTimer startupTimer;
+    startupTimer.start();
     
-    if (!db_.open()) {
-        qCritical() << "Failed to open database:" << db_.lastError().text();
+    dbPath_ = dbPath;
+    
+    // 主线程连接同时负责建表；其余线程首次访问时各自建立连接
+    QSqlDatabase db = connection();
+    if (!db.isOpen()) {
         return false;
     }
     
@@ -48,7 +56,7 @@ bool Database::initialize(const QString& dbPath)
     }
     
     // 检查是否已存在admin玩家
-    QSqlQuery query(db_);
+    QSqlQuery query(db);
     query.prepare("SELECT player_id FROM players WHERE player_id = ?");
     query.addBindValue("admin");
     
@@ -72,6 +80,7 @@ bool Database::initialize(const QString& dbPath)
         return false;
     }
     
+    qDebug() << "Database ready in" << startupTimer.elapsed() << "ms";
     return true;
 }
 
@@ -81,9 +90,145 @@ bool Database::initialize(const QString& dbPath)
  */
 void Database::close()
 {
-    if (db_.isOpen()) {
-        db_.close();
+    QMutexLocker locker(&poolMutex_);
+    for (const QString& name : connectionNames_) {
+        releaseConnection(name);
+    }
+    connectionNames_.clear();
+}
+
+/**
+ * @brief 释放一个命名连接及其语句缓存（调用方持有 poolMutex_）
+ */
+void Database::releaseConnection(const QString& name)
+{
+    // 预编译语句必须先于连接销毁
+    delete statementCaches_.take(name);
+    
+    {
+        QSqlDatabase db = QSqlDatabase::database(name, false);
+        if (db.isOpen()) {
+            db.close();
+        }
+    }
+    QSqlDatabase::removeDatabase(name);
+}
+
+/**
+ * @brief 获取当前线程连接上的预编译语句
+ * 
+ * 同一连接上每个语句ID只 prepare 一次，之后只绑定参数并执行。
+ * 返回的引用在本线程内有效；SELECT 读完后调用 finish() 释放读快照。
+ */
+QSqlQuery& Database::statement(Statement id, const char* sql)
+{
+    QSqlDatabase db = connection();
+    
+    StatementCache* cache = nullptr;
+    {
+        QMutexLocker locker(&poolMutex_);
+        cache = statementCaches_.value(db.connectionName(), nullptr);
+        if (!cache) {
+            cache = new StatementCache();
+            statementCaches_.insert(db.connectionName(), cache);
+        }
+    }
+    
+    std::unique_ptr<QSqlQuery>& slot = cache->statements[static_cast<int>(id)];
+    if (!slot) {
+        slot.reset(new QSqlQuery(db));
+        if (!slot->prepare(QString::fromUtf8(sql))) {
+            qCritical() << "Failed to prepare statement" << static_cast<int>(id) << ":" << slot->lastError().text();
+        }
+    }
+    
+    return *slot;
+}
+
+/**
+ * @brief 获取当前线程专属的数据库连接
+ * 
+ * QSqlDatabase 连接不能跨线程使用，因此按线程命名（fruitcrush_<线程ID>）懒创建，
+ * 所有连接指向同一个 SQLite 文件，在 WAL 模式下读写可以并发进行。
+ * 非主线程的连接在该线程结束时自动移除。
+ */
+QSqlDatabase Database::connection()
+{
+    const QString name = QString("fruitcrush_%1")
+        .arg(reinterpret_cast<quintptr>(QThread::currentThreadId()));
+    
+    if (QSqlDatabase::contains(name)) {
+        return QSqlDatabase::database(name);
+    }
+    
+    if (dbPath_.isEmpty()) {
+        qCritical() << "Database connection requested before initialize()";
+        return QSqlDatabase();
     }
+    
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", name);
+    db.setDatabaseName(dbPath_);
+    if (!openConnection(db)) {
+        // 注销失败的连接：否则下次会走 contains() 快路径，由 Qt 静默重开（没有连接参数，也不会被释放）
+        db.close();
+        db = QSqlDatabase();
+        QSqlDatabase::removeDatabase(name);
+        return QSqlDatabase();
+    }
+    
+    {
+        QMutexLocker locker(&poolMutex_);
+        connectionNames_.append(name);
+    }
+    
+    // 工作线程退出时释放其连接
+    QThread* thread = QThread::currentThread();
+    if (thread != qApp->thread()) {
+        QObject::connect(thread, &QThread::finished, [this, name]() {
+            QMutexLocker locker(&poolMutex_);
+            if (connectionNames_.removeOne(name)) {
+                releaseConnection(name);
+            }
+        });
+    }
+    
+    return db;
+}
+
+/**
+ * @brief 打开连接并设置连接级参数
+ */
+bool Database::openConnection(QSqlDatabase& db)
+{
+    if (!db.open()) {
+        qCritical() << "Failed to open database:" << db.lastError().text();
+        return false;
+    }
+    
+    // 连接级性能参数
+    // - journal_mode=WAL：读不阻塞写，多个线程的连接可以同时工作
+    // - synchronous=NORMAL：WAL 下只在检查点 fsync，掉电最多丢最后一个事务，不会损坏
+    // - cache_size=-8192：每个连接 8MB 页缓存（负数单位为 KB）
+    // - mmap_size：64MB 内存映射读取，减少 read() 系统调用
+    // - temp_store=MEMORY：排序/临时表放内存
+    // - busy_timeout：写锁冲突时等待而不是立即返回 SQLITE_BUSY
+    static const char* const kPragmas[] = {
+        "PRAGMA journal_mode=WAL",
+        "PRAGMA synchronous=NORMAL",
+        "PRAGMA cache_size=-8192",
+        "PRAGMA mmap_size=67108864",
+        "PRAGMA temp_store=MEMORY",
+        "PRAGMA busy_timeout=5000"
+    };
+    
+    QSqlQuery query(db);
+    for (const char* pragma : kPragmas) {
+        if (!query.exec(pragma)) {
+            qWarning() << "Failed to apply" << pragma << ":" << query.lastError().text();
+        }
+    }
+    
+    return true;
 }
 
 /**
@@ -91,7 +236,8 @@ void Database::close()
  */
 bool Database::tableExists(const QString& tableName)
 {
-    QSqlQuery query(db_);
+    QSqlDatabase db = connection();
+    QSqlQuery query(db);
     query.prepare("SELECT name FROM sqlite_master WHERE type='table' AND name=?");
     query.addBindValue(tableName);
     
@@ -104,12 +250,123 @@ bool Database::tableExists(const QString& tableName)
 }
 
 /**
- * @brief 创建数据库表结构
+ * @brief 创建/升级数据库表结构
+ * 
+ * schema_version 记录已应用的迁移；启动时只读取当前版本，
+ * 按顺序执行版本号更大的迁移（每个迁移一个事务）。结构已是最新时不执行任何 DDL。
+ * 新增表结构时在迁移列表末尾追加一项，不要修改已发布的迁移。
  */
 bool Database::createTables()
 {
-    QSqlQuery query(db_);
+    struct SchemaMigration {
+        int version;
+        const char* description;
+        bool (Database::*apply)(QSqlQuery&);
+    };
+    
+    static const SchemaMigration kMigrations[] = {
+        { 1, "base tables",          &Database::migrateV1BaseTables },
+        { 2, "player prop columns",  &Database::migrateV2PlayerPropColumns },
+        { 3, "competition best",     &Database::migrateV3CompetitionBest },
+        { 4, "windowed leaderboards", &Database::migrateV4WindowBest },
+        { 5, "history indexes",      &Database::migrateV5HistoryIndexes },
+    };
+    
+    QSqlDatabase db = connection();
+    QSqlQuery query(db);
+    
+    int current = schemaVersion();
+    if (current < 0) {
+        return false;
+    }
+    
+    for (const auto& migration : kMigrations) {
+        if (migration.version <= current) {
+            continue;
+        }
+        
+        if (!db.transaction()) {
+            qCritical() << "Failed to begin migration" << migration.version << ":" << db.lastError().text();
+            return false;
+        }
+        
+        // 1. 版本表本身（首次迁移时创建）
+        bool ok = query.exec(R"(
+            CREATE TABLE IF NOT EXISTS schema_version (
+                version INTEGER PRIMARY KEY,
+                description TEXT NOT NULL,
+                applied_at TEXT NOT NULL
+            )
+        )");
+        
+        // 2. 迁移内容
+        ok = ok && (this->*migration.apply)(query);
+        
+        // 3. 记录版本
+        if (ok) {
+            query.prepare("INSERT INTO schema_version (version, description, applied_at) VALUES (?, ?, ?)");
+            query.addBindValue(migration.version);
+            query.addBindValue(QString::fromUtf8(migration.description));
+            query.addBindValue(QDateTime::currentDateTime().toString(Qt::ISODate));
+            ok = query.exec();
+        }
+        
+        if (!ok || !db.commit()) {
+            qCritical() << "Schema migration" << migration.version << "failed:" << query.lastError().text();
+            db.rollback();
+            return false;
+        }
+        
+        qDebug() << "Applied schema migration" << migration.version << migration.description;
+        current = migration.version;
+    }
+    
+    return true;
+}
+
+/**
+ * @brief 读取当前结构版本
+ * @return 已应用的最大版本号；没有版本表返回0，查询失败返回-1
+ */
+int Database::schemaVersion()
+{
+    if (!tableExists("schema_version")) {
+        return 0;
+    }
+    
+    QSqlQuery query(connection());
+    if (!query.exec("SELECT MAX(version) FROM schema_version")) {
+        qCritical() << "Failed to read schema version:" << query.lastError().text();
+        return -1;
+    }
+    
+    return query.next() ? query.value(0).toInt() : 0;
+}
+
+/**
+ * @brief 检查表中是否存在某列
+ */
+bool Database::columnExists(QSqlQuery& query, const QString& tableName, const QString& columnName)
+{
+    if (!query.exec(QString("PRAGMA table_info(%1)").arg(tableName))) {
+        return false;
+    }
     
+    while (query.next()) {
+        if (query.value(1).toString() == columnName) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief 迁移1：基础表与索引
+ * 
+ * 使用 IF NOT EXISTS，兼容没有版本表的旧数据库
+ */
+bool Database::migrateV1BaseTables(QSqlQuery& query)
+{
     // 1. 创建玩家表
     QString createPlayersTable = R"(
         CREATE TABLE IF NOT EXISTS players (
@@ -129,11 +386,6 @@ bool Database::createTables()
         return false;
     }
     
-    // 尝试添加道具字段（如果表已存在但缺少这些字段）
-    query.exec("ALTER TABLE players ADD COLUMN hammer_count INTEGER DEFAULT 3");
-    query.exec("ALTER TABLE players ADD COLUMN clamp_count INTEGER DEFAULT 3");
-    query.exec("ALTER TABLE players ADD COLUMN magic_wand_count INTEGER DEFAULT 3");
-    
     // 2. 创建成就进度表
     QString createAchievementsTable = R"(
         CREATE TABLE IF NOT EXISTS achievement_progress (
@@ -191,11 +443,245 @@ bool Database::createTables()
         return false;
     }
     
-    // 创建索引以提升查询性能
-    query.exec("CREATE INDEX IF NOT EXISTS idx_achievement_player ON achievement_progress(player_id)");
-    query.exec("CREATE INDEX IF NOT EXISTS idx_game_records_player ON game_records(player_id)");
-    query.exec("CREATE INDEX IF NOT EXISTS idx_competition_records_duration ON competition_records(duration_type)");
-    query.exec("CREATE INDEX IF NOT EXISTS idx_competition_records_score ON competition_records(score DESC)");
+    // 5. 创建休闲模式棋盘存档表（每个玩家一行，主键即索引）
+    QString createCasualBoardsTable = R"(
+        CREATE TABLE IF NOT EXISTS casual_boards (
+            player_id TEXT PRIMARY KEY,
+            map_size INTEGER NOT NULL,
+            board BLOB NOT NULL,
+            saved_at TEXT NOT NULL,
+            FOREIGN KEY (player_id) REFERENCES players(player_id)
+        )
+    )";
+    
+    if (!query.exec(createCasualBoardsTable)) {
+        qCritical() << "Failed to create casual_boards table:" << query.lastError().text();
+        return false;
+    }
+    
+    // 6. 索引
+    static const char* const kIndexes[] = {
+        "CREATE INDEX IF NOT EXISTS idx_achievement_player ON achievement_progress(player_id)",
+        "CREATE INDEX IF NOT EXISTS idx_game_records_player ON game_records(player_id)",
+        "CREATE INDEX IF NOT EXISTS idx_competition_records_duration ON competition_records(duration_type)",
+        "CREATE INDEX IF NOT EXISTS idx_competition_records_score ON competition_records(score DESC)"
+    };
+    for (const char* sql : kIndexes) {
+        if (!query.exec(sql)) {
+            qCritical() << "Failed to create index:" << query.lastError().text();
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+/**
+ * @brief 迁移2：旧版 players 表补齐道具字段
+ * 
+ * 旧版本在每次启动时盲目执行 ALTER TABLE 并忽略错误；这里只补缺失的列
+ */
+bool Database::migrateV2PlayerPropColumns(QSqlQuery& query)
+{
+    static const char* const kColumns[] = { "hammer_count", "clamp_count", "magic_wand_count" };
+    
+    for (const char* column : kColumns) {
+        if (columnExists(query, "players", column)) {
+            continue;
+        }
+        if (!query.exec(QString("ALTER TABLE players ADD COLUMN %1 INTEGER DEFAULT 3").arg(column))) {
+            qCritical() << "Failed to add players." << column << ":" << query.lastError().text();
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+/**
+ * @brief 迁移3：每个玩家每种时长的最佳成绩表
+ * 
+ * 排行榜、排名、个人最佳只查这张表（每个玩家一行），与历史记录条数无关。
+ * 覆盖索引按 (时长, 分数降序, 时间升序) 排列，Top-N 与排名计数都只走索引。
+ */
+bool Database::migrateV3CompetitionBest(QSqlQuery& query)
+{
+    // 1. 最佳成绩表
+    QString createCompetitionBestTable = R"(
+        CREATE TABLE IF NOT EXISTS competition_best (
+            player_id TEXT NOT NULL,
+            duration_type TEXT NOT NULL,
+            player_name TEXT NOT NULL,
+            best_score INTEGER NOT NULL,
+            max_combo INTEGER DEFAULT 0,
+            played_at TEXT NOT NULL,
+            PRIMARY KEY (player_id, duration_type)
+        ) WITHOUT ROWID
+    )";
+    
+    if (!query.exec(createCompetitionBestTable)) {
+        qCritical() << "Failed to create competition_best table:" << query.lastError().text();
+        return false;
+    }
+    
+    // 2. 覆盖索引
+    if (!query.exec(R"(
+        CREATE INDEX IF NOT EXISTS idx_competition_best_rank
+        ON competition_best(duration_type, best_score DESC, played_at ASC, player_id, player_name, max_combo)
+    )")) {
+        qCritical() << "Failed to create competition_best index:" << query.lastError().text();
+        return false;
+    }
+    
+    // 3. 从历史记录回填
+    return backfillCompetitionBest(query);
+}
+
+/**
+ * @brief 迁移4：日/周/赛季排行榜的分桶最佳成绩表
+ * 
+ * window_type 对应 LeaderboardWindow（1日 2周 3赛季），bucket 为整数桶号：
+ * 日 = 1970-01-01 起的本地天数，周 = (天数 + 3) / 7（周一为一周起点），赛季 = 天数 / 28。
+ * 每个桶内每个玩家一行，查询只在当前桶的索引区间内进行，与历史记录条数无关。
+ */
+bool Database::migrateV4WindowBest(QSqlQuery& query)
+{
+    // 1. 分桶最佳成绩表
+    QString createWindowBestTable = R"(
+        CREATE TABLE IF NOT EXISTS competition_window_best (
+            window_type INTEGER NOT NULL,
+            bucket INTEGER NOT NULL,
+            duration_type TEXT NOT NULL,
+            player_id TEXT NOT NULL,
+            player_name TEXT NOT NULL,
+            best_score INTEGER NOT NULL,
+            max_combo INTEGER DEFAULT 0,
+            played_at TEXT NOT NULL,
+            PRIMARY KEY (window_type, bucket, duration_type, player_id)
+        ) WITHOUT ROWID
+    )";
+    
+    if (!query.exec(createWindowBestTable)) {
+        qCritical() << "Failed to create competition_window_best table:" << query.lastError().text();
+        return false;
+    }
+    
+    // 2. 覆盖索引
+    if (!query.exec(R"(
+        CREATE INDEX IF NOT EXISTS idx_competition_window_rank
+        ON competition_window_best(window_type, bucket, duration_type, best_score DESC, played_at ASC,
+                                   player_id, player_name, max_combo)
+    )")) {
+        qCritical() << "Failed to create competition_window_best index:" << query.lastError().text();
+        return false;
+    }
+    
+    // 3. 从历史记录回填
+    return backfillWindowBest(query);
+}
+
+/**
+ * @brief 从 competition_records 回填 competition_best（同分取最早达成的一条）
+ * 
+ * 用窗口函数在每个分组内显式选出第一名，不依赖 INSERT 按 ORDER BY 顺序处理冲突
+ */
+bool Database::backfillCompetitionBest(QSqlQuery& query)
+{
+    if (!query.exec(R"(
+        INSERT INTO competition_best
+        (player_id, duration_type, player_name, best_score, max_combo, played_at)
+        SELECT player_id, duration_type, player_name, score, max_combo, played_at
+        FROM (
+            SELECT *, ROW_NUMBER() OVER (
+                       PARTITION BY player_id, duration_type
+                       ORDER BY score DESC, played_at ASC, id ASC) AS rank_in_group
+            FROM competition_records
+        )
+        WHERE rank_in_group = 1
+    )")) {
+        qCritical() << "Failed to backfill competition_best:" << query.lastError().text();
+        return false;
+    }
+    
+    return true;
+}
+
+/**
+ * @brief 从 competition_records 回填 competition_window_best（同分取最早达成的一条）
+ * 
+ * played_at 前10位为本地日期；2440587.5 为 1970-01-01 的儒略日
+ */
+bool Database::backfillWindowBest(QSqlQuery& query)
+{
+    if (!query.exec(R"(
+        INSERT INTO competition_window_best
+        (window_type, bucket, duration_type, player_id, player_name, best_score, max_combo, played_at)
+        SELECT window_type, bucket, duration_type, player_id, player_name, score, max_combo, played_at
+        FROM (
+            SELECT b.*, ROW_NUMBER() OVER (
+                       PARTITION BY b.window_type, b.bucket, b.duration_type, b.player_id
+                       ORDER BY b.score DESC, b.played_at ASC, b.id ASC) AS rank_in_group
+            FROM (
+                SELECT w.window_type,
+                       CASE w.window_type
+                           WHEN 1 THEN r.day
+                           WHEN 2 THEN (r.day + 3) / 7
+                           ELSE r.day / 28
+                       END AS bucket,
+                       r.id, r.duration_type, r.player_id, r.player_name, r.score, r.max_combo, r.played_at
+                FROM (
+                    SELECT *, CAST(julianday(substr(played_at, 1, 10)) - 2440587.5 AS INTEGER) AS day
+                    FROM competition_records
+                ) r
+                CROSS JOIN (SELECT 1 AS window_type UNION ALL SELECT 2 UNION ALL SELECT 3) w
+                WHERE r.day IS NOT NULL
+            ) b
+        )
+        WHERE rank_in_group = 1
+    )")) {
+        qCritical() << "Failed to backfill competition_window_best:" << query.lastError().text();
+        return false;
+    }
+    
+    return true;
+}
+
+/**
+ * @brief 按 competition_records 重建排行榜汇总表（批量导入后调用，调用方负责事务）
+ */
+bool Database::rebuildCompetitionAggregates()
+{
+    QSqlQuery query(connection());
+    
+    if (!query.exec("DELETE FROM competition_best") || !query.exec("DELETE FROM competition_window_best")) {
+        qCritical() << "Failed to clear competition aggregates:" << query.lastError().text();
+        return false;
+    }
+    
+    return backfillCompetitionBest(query) && backfillWindowBest(query);
+}
+
+/**
+ * @brief 迁移5：历史记录分页与统计索引
+ * 
+ * (player_id, played_at, id) 支持键集分页；(player_id, mode, score, max_combo) 覆盖按模式汇总。
+ * 旧的 idx_game_records_player 是新索引的前缀，删除以减少写放大。
+ */
+bool Database::migrateV5HistoryIndexes(QSqlQuery& query)
+{
+    static const char* const kStatements[] = {
+        "CREATE INDEX IF NOT EXISTS idx_game_records_page ON game_records(player_id, played_at, id)",
+        "CREATE INDEX IF NOT EXISTS idx_game_records_stats ON game_records(player_id, mode, score, max_combo)",
+        "CREATE INDEX IF NOT EXISTS idx_competition_records_page ON competition_records(player_id, duration_type, played_at, id)",
+        "DROP INDEX IF EXISTS idx_game_records_player"
+    };
+    
+    for (const char* sql : kStatements) {
+        if (!query.exec(sql)) {
+            qCritical() << "Failed to create history index:" << query.lastError().text();
+            return false;
+        }
+    }
     
     return true;
 }
@@ -207,7 +693,8 @@ bool Database::createTables()
  */
 bool Database::createPlayer(const QString& playerId, const QString& username)
 {
-    QSqlQuery query(db_);
+    QSqlDatabase db = connection();
+    QSqlQuery query(db);
     query.prepare(R"(
         INSERT INTO players (player_id, username, total_points, hammer_count, clamp_count, magic_wand_count, created_at, last_login)
         VALUES (?, ?, 0, 3, 3, 3, ?, ?)
@@ -232,10 +719,11 @@ bool Database::createPlayer(const QString& playerId, const QString& username)
  */
 PlayerData Database::getPlayer(const QString& playerId)
 {
+    QSqlDatabase db = connection();
     PlayerData data;
     // 注意：playerId 初始为空，只有在数据库中找到玩家时才设置
     
-    QSqlQuery query(db_);
+    QSqlQuery query(db);
     query.prepare("SELECT player_id, username, total_points, created_at, last_login FROM players WHERE player_id = ?");
     query.addBindValue(playerId);
     
@@ -261,7 +749,8 @@ PlayerData Database::getPlayer(const QString& playerId)
  */
 bool Database::updatePlayerPoints(const QString& playerId, int points)
 {
-    QSqlQuery query(db_);
+    QSqlDatabase db = connection();
+    QSqlQuery query(db);
     query.prepare("UPDATE players SET total_points = total_points + ? WHERE player_id = ?");
     query.addBindValue(points);
     query.addBindValue(playerId);
@@ -279,7 +768,8 @@ bool Database::updatePlayerPoints(const QString& playerId, int points)
  */
 bool Database::updateLastLogin(const QString& playerId)
 {
-    QSqlQuery query(db_);
+    QSqlDatabase db = connection();
+    QSqlQuery query(db);
     query.prepare("UPDATE players SET last_login = ? WHERE player_id = ?");
     query.addBindValue(QDateTime::currentDateTime().toString(Qt::ISODate));
     query.addBindValue(playerId);
@@ -297,8 +787,8 @@ bool Database::updateLastLogin(const QString& playerId)
  */
 int Database::getPlayerScore(const QString& playerId)
 {
-    QSqlQuery query(db_);
-    query.prepare("SELECT total_points FROM players WHERE player_id = ?");
+    QSqlQuery& query = statement(Statement::GET_PLAYER_SCORE,
+        "SELECT total_points FROM players WHERE player_id = ?");
     query.addBindValue(playerId);
     
     if (!query.exec()) {
@@ -306,11 +796,13 @@ int Database::getPlayerScore(const QString& playerId)
         return 0;
     }
     
+    int score = 0;
     if (query.next()) {
-        return query.value(0).toInt();
+        score = query.value(0).toInt();
     }
+    query.finish();
     
-    return 0;
+    return score;
 }
 
 /**
@@ -318,8 +810,8 @@ int Database::getPlayerScore(const QString& playerId)
  */
 bool Database::savePlayerScore(const QString& playerId, int score)
 {
-    QSqlQuery query(db_);
-    query.prepare("UPDATE players SET total_points = ? WHERE player_id = ?");
+    QSqlQuery& query = statement(Statement::SAVE_PLAYER_SCORE,
+        "UPDATE players SET total_points = ? WHERE player_id = ?");
     query.addBindValue(score);
     query.addBindValue(playerId);
     
@@ -343,8 +835,8 @@ Database::PropData Database::getPlayerProps(const QString& playerId)
 {
     PropData props;  // 默认值 3, 3, 3
     
-    QSqlQuery query(db_);
-    query.prepare("SELECT hammer_count, clamp_count, magic_wand_count FROM players WHERE player_id = ?");
+    QSqlQuery& query = statement(Statement::GET_PLAYER_PROPS,
+        "SELECT hammer_count, clamp_count, magic_wand_count FROM players WHERE player_id = ?");
     query.addBindValue(playerId);
     
     if (!query.exec()) {
@@ -357,6 +849,7 @@ Database::PropData Database::getPlayerProps(const QString& playerId)
         props.clampCount = query.value(1).toInt();
         props.magicWandCount = query.value(2).toInt();
     }
+    query.finish();
     
     return props;
 }
@@ -366,8 +859,8 @@ Database::PropData Database::getPlayerProps(const QString& playerId)
  */
 bool Database::savePlayerProps(const QString& playerId, int hammer, int clamp, int magicWand)
 {
-    QSqlQuery query(db_);
-    query.prepare("UPDATE players SET hammer_count = ?, clamp_count = ?, magic_wand_count = ? WHERE player_id = ?");
+    QSqlQuery& query = statement(Statement::SAVE_PLAYER_PROPS,
+        "UPDATE players SET hammer_count = ?, clamp_count = ?, magic_wand_count = ? WHERE player_id = ?");
     query.addBindValue(hammer);
     query.addBindValue(clamp);
     query.addBindValue(magicWand);
@@ -386,6 +879,59 @@ bool Database::savePlayerProps(const QString& playerId, int hammer, int clamp, i
     return true;
 }
 
+// ==================== 棋盘存档操作 ====================
+
+/**
+ * @brief 保存休闲模式棋盘存档（覆盖旧存档）
+ */
+bool Database::saveCasualBoard(const QString& playerId, const QByteArray& board)
+{
+    QSqlDatabase db = connection();
+    if (board.size() < 6) {
+        qWarning() << "Invalid casual board data for player:" << playerId;
+        return false;
+    }
+    
+    QSqlQuery query(db);
+    query.prepare(R"(
+        INSERT OR REPLACE INTO casual_boards (player_id, map_size, board, saved_at)
+        VALUES (?, ?, ?, ?)
+    )");
+    query.addBindValue(playerId);
+    query.addBindValue(static_cast<int>(static_cast<uchar>(board.at(5))));  // 头部第5字节为地图大小
+    query.addBindValue(board);
+    query.addBindValue(QDateTime::currentDateTime().toString(Qt::ISODate));
+    
+    if (!query.exec()) {
+        qCritical() << "Failed to save casual board:" << query.lastError().text();
+        return false;
+    }
+    
+    return true;
+}
+
+/**
+ * @brief 读取休闲模式棋盘存档（主键单行查询）
+ */
+QByteArray Database::loadCasualBoard(const QString& playerId)
+{
+    QSqlDatabase db = connection();
+    QSqlQuery query(db);
+    query.prepare("SELECT board FROM casual_boards WHERE player_id = ?");
+    query.addBindValue(playerId);
+    
+    if (!query.exec()) {
+        qWarning() << "Failed to load casual board:" << query.lastError().text();
+        return QByteArray();
+    }
+    
+    if (query.next()) {
+        return query.value(0).toByteArray();
+    }
+    
+    return QByteArray();
+}
+
 // ==================== 成就进度操作 ====================
 
 /**
@@ -401,26 +947,49 @@ bool Database::initializeAchievements(const QString& playerId)
         return true;
     }
     
-    QSqlQuery query(db_);
+    // 多行 INSERT OR IGNORE（避免重复插入），每条语句最多 ROWS_PER_INSERT 行以控制绑定参数数量
+    static const int ROWS_PER_INSERT = 200;
     
-    for (auto it = achievements.constBegin(); it != achievements.constEnd(); ++it) {
-        const QString& achievementId = it.key();
-        const AchievementDef& def = it.value();
+    QSqlDatabase db = connection();
+    if (!db.transaction()) {
+        qCritical() << "Failed to begin achievement init transaction:" << db.lastError().text();
+        return false;
+    }
+    
+    QSqlQuery query(db);
+    auto it = achievements.constBegin();
+    int remaining = achievements.size();
+    
+    while (remaining > 0) {
+        const int rows = qMin(remaining, ROWS_PER_INSERT);
         
-        // INSERT OR IGNORE 避免重复插入
-        query.prepare(R"(
+        QString sql = R"(
             INSERT OR IGNORE INTO achievement_progress 
             (player_id, achievement_id, current_value, target_value, state)
-            VALUES (?, ?, 0, ?, 0)
-        )");
-        query.addBindValue(playerId);
-        query.addBindValue(achievementId);
-        query.addBindValue(def.targetValue);
+            VALUES )";
+        for (int i = 0; i < rows; ++i) {
+            sql += (i == 0) ? "(?, ?, 0, ?, 0)" : ", (?, ?, 0, ?, 0)";
+        }
+        query.prepare(sql);
+        
+        for (int i = 0; i < rows; ++i, ++it) {
+            query.addBindValue(playerId);
+            query.addBindValue(it.key());
+            query.addBindValue(it.value().targetValue);
+        }
         
         if (!query.exec()) {
-            qCritical() << "Failed to initialize achievement" << achievementId << ":" << query.lastError().text();
+            qCritical() << "Failed to initialize achievements:" << query.lastError().text();
+            db.rollback();
             return false;
         }
+        remaining -= rows;
+    }
+    
+    if (!db.commit()) {
+        qCritical() << "Failed to commit achievement init:" << db.lastError().text();
+        db.rollback();
+        return false;
     }
     
     return true;
@@ -438,8 +1007,7 @@ AchievementProgress Database::getAchievementProgress(const QString& playerId, co
     progress.targetValue = 0;
     progress.state = AchievementState::LOCKED;
     
-    QSqlQuery query(db_);
-    query.prepare(R"(
+    QSqlQuery& query = statement(Statement::GET_ACHIEVEMENT_PROGRESS, R"(
         SELECT current_value, target_value, state, completed_at
         FROM achievement_progress
         WHERE player_id = ? AND achievement_id = ?
@@ -462,6 +1030,7 @@ AchievementProgress Database::getAchievementProgress(const QString& playerId, co
             progress.completedAt = QDateTime::fromString(completedAtStr, Qt::ISODate);
         }
     }
+    query.finish();
     
     return progress;
 }
@@ -473,8 +1042,7 @@ QList<AchievementProgress> Database::getAllAchievementProgress(const QString& pl
 {
     QList<AchievementProgress> progressList;
     
-    QSqlQuery query(db_);
-    query.prepare(R"(
+    QSqlQuery& query = statement(Statement::GET_ALL_ACHIEVEMENT_PROGRESS, R"(
         SELECT achievement_id, current_value, target_value, state, completed_at
         FROM achievement_progress
         WHERE player_id = ?
@@ -503,6 +1071,7 @@ QList<AchievementProgress> Database::getAllAchievementProgress(const QString& pl
         
         progressList.append(progress);
     }
+    query.finish();
     
     return progressList;
 }
@@ -512,8 +1081,7 @@ QList<AchievementProgress> Database::getAllAchievementProgress(const QString& pl
  */
 bool Database::updateAchievementProgress(const QString& playerId, const QString& achievementId, int currentValue)
 {
-    QSqlQuery query(db_);
-    query.prepare(R"(
+    QSqlQuery& query = statement(Statement::UPDATE_ACHIEVEMENT_PROGRESS, R"(
         UPDATE achievement_progress
         SET current_value = ?
         WHERE player_id = ? AND achievement_id = ?
@@ -535,7 +1103,8 @@ bool Database::updateAchievementProgress(const QString& playerId, const QString&
  */
 bool Database::completeAchievement(const QString& playerId, const QString& achievementId)
 {
-    QSqlQuery query(db_);
+    QSqlDatabase db = connection();
+    QSqlQuery query(db);
     query.prepare(R"(
         UPDATE achievement_progress
         SET state = ?, completed_at = ?
@@ -555,16 +1124,87 @@ bool Database::completeAchievement(const QString& playerId, const QString& achie
 }
 
 
+/**
+ * @brief 批量写入成就进度与完成状态（单事务）
+ * 
+ * 同一事务内先写进度再写完成状态；只会推进进度、不会把已领取的成就改回已完成
+ */
+bool Database::saveAchievementProgressBatch(const QString& playerId, const QList<AchievementProgress>& progressList)
+{
+    QSqlDatabase db = connection();
+    if (progressList.isEmpty()) {
+        return true;
+    }
+    
+    if (!db.transaction()) {
+        qCritical() << "Failed to begin achievement batch transaction:" << db.lastError().text();
+        return false;
+    }
+    
+    QSqlQuery& progressQuery = statement(Statement::ADVANCE_ACHIEVEMENT_PROGRESS, R"(
+        UPDATE achievement_progress
+        SET current_value = ?
+        WHERE player_id = ? AND achievement_id = ? AND current_value < ?
+    )");
+    
+    QSqlQuery& completeQuery = statement(Statement::COMPLETE_LOCKED_ACHIEVEMENT, R"(
+        UPDATE achievement_progress
+        SET state = ?, completed_at = ?
+        WHERE player_id = ? AND achievement_id = ? AND state = ?
+    )");
+    
+    const QString now = QDateTime::currentDateTime().toString(Qt::ISODate);
+    
+    // 1. 进度
+    for (const auto& progress : progressList) {
+        progressQuery.addBindValue(progress.currentValue);
+        progressQuery.addBindValue(playerId);
+        progressQuery.addBindValue(progress.achievementId);
+        progressQuery.addBindValue(progress.currentValue);
+        if (!progressQuery.exec()) {
+            db.rollback();
+            qCritical() << "Failed to update achievement progress:" << progressQuery.lastError().text();
+            return false;
+        }
+    }
+    
+    // 2. 完成状态
+    for (const auto& progress : progressList) {
+        if (progress.state != AchievementState::COMPLETED) {
+            continue;
+        }
+        completeQuery.addBindValue(static_cast<int>(AchievementState::COMPLETED));
+        completeQuery.addBindValue(now);
+        completeQuery.addBindValue(playerId);
+        completeQuery.addBindValue(progress.achievementId);
+        completeQuery.addBindValue(static_cast<int>(AchievementState::LOCKED));
+        if (!completeQuery.exec()) {
+            db.rollback();
+            qCritical() << "Failed to complete achievement:" << completeQuery.lastError().text();
+            return false;
+        }
+    }
+    
+    if (!db.commit()) {
+        qCritical() << "Failed to commit achievement batch:" << db.lastError().text();
+        db.rollback();
+        return false;
+    }
+    
+    return true;
+}
+
 /**
  * @brief 领取成就奖励
  */
 bool Database::claimAchievementReward(const QString& playerId, const QString& achievementId, int reward)
 {
+    QSqlDatabase db = connection();
     // 开启事务
-    db_.transaction();
+    db.transaction();
     
     // 1. 更新成就状态为已领取
-    QSqlQuery query1(db_);
+    QSqlQuery query1(db);
     query1.prepare(R"(
         UPDATE achievement_progress
         SET state = ?
@@ -575,25 +1215,25 @@ bool Database::claimAchievementReward(const QString& playerId, const QString& ac
     query1.addBindValue(achievementId);
     
     if (!query1.exec()) {
-        db_.rollback();
+        db.rollback();
         qCritical() << "Failed to claim achievement:" << query1.lastError().text();
         return false;
     }
     
     // 2. 增加玩家点数
-    QSqlQuery query2(db_);
+    QSqlQuery query2(db);
     query2.prepare("UPDATE players SET total_points = total_points + ? WHERE player_id = ?");
     query2.addBindValue(reward);
     query2.addBindValue(playerId);
     
     if (!query2.exec()) {
-        db_.rollback();
+        db.rollback();
         qCritical() << "Failed to update points:" << query2.lastError().text();
         return false;
     }
     
     // 提交事务
-    db_.commit();
+    db.commit();
     return true;
 }
 
@@ -604,7 +1244,8 @@ bool Database::claimAchievementReward(const QString& playerId, const QString& ac
  */
 bool Database::saveGameRecord(const GameRecord& record)
 {
-    QSqlQuery query(db_);
+    QSqlDatabase db = connection();
+    QSqlQuery query(db);
     query.prepare(R"(
         INSERT INTO game_records (player_id, mode, score, max_combo, played_at)
         VALUES (?, ?, ?, ?, ?)
@@ -629,44 +1270,110 @@ bool Database::saveGameRecord(const GameRecord& record)
 QList<GameRecord> Database::getGameRecords(const QString& playerId, int limit)
 {
     QList<GameRecord> records;
+    forEachGameRecord(playerId, RecordCursor(), limit, [&records](const GameRecord& record) {
+        records.append(record);
+    });
+    return records;
+}
+
+/**
+ * @brief 键集分页读取游戏记录
+ * 
+ * WHERE (played_at, id) < (游标) 直接定位到索引位置，翻到任意深度都不需要 OFFSET 扫描
+ */
+RecordCursor Database::forEachGameRecord(const QString& playerId, const RecordCursor& after, int pageSize,
+                                         const std::function<void(const GameRecord&)>& visitor)
+{
+    RecordCursor next;
     
-    QSqlQuery query(db_);
-    query.prepare(R"(
-        SELECT mode, score, max_combo, played_at
+    QSqlQuery& query = statement(Statement::PAGE_GAME_RECORDS, R"(
+        SELECT id, mode, score, max_combo, played_at
         FROM game_records
-        WHERE player_id = ?
-        ORDER BY played_at DESC
+        WHERE player_id = ? AND (played_at, id) < (?, ?)
+        ORDER BY played_at DESC, id DESC
         LIMIT ?
     )");
     query.addBindValue(playerId);
-    query.addBindValue(limit);
+    // 起始页用比任何 ISO 时间都大的哨兵
+    query.addBindValue(after.atEnd() ? QString("9999") : after.playedAt);
+    query.addBindValue(after.atEnd() ? std::numeric_limits<qint64>::max() : after.id);
+    query.addBindValue(pageSize);
     
     if (!query.exec()) {
         qCritical() << "Failed to get game records:" << query.lastError().text();
-        return records;
+        return next;
     }
     
+    int rows = 0;
+    GameRecord record;
+    record.playerId = playerId;
+    QString lastPlayedAt;
     while (query.next()) {
-        GameRecord record;
-        record.playerId = playerId;
-        record.mode = query.value(0).toString();
-        record.score = query.value(1).toInt();
-        record.maxCombo = query.value(2).toInt();
-        record.playedAt = QDateTime::fromString(query.value(3).toString(), Qt::ISODate);
-        records.append(record);
+        record.recordId = query.value(0).toLongLong();
+        record.mode = query.value(1).toString();
+        record.score = query.value(2).toInt();
+        record.maxCombo = query.value(3).toInt();
+        lastPlayedAt = query.value(4).toString();
+        record.playedAt = QDateTime::fromString(lastPlayedAt, Qt::ISODate);
+        visitor(record);
+        ++rows;
     }
+    query.finish();
     
-    return records;
+    // 满页才可能还有下一页
+    if (rows == pageSize) {
+        next.playedAt = lastPlayedAt;
+        next.id = record.recordId;
+    }
+    return next;
 }
 
 // ==================== 统计查询 ====================
 
+/**
+ * @brief 按模式汇总玩家统计（局数、平均分、最高分、最大连击）
+ * 
+ * 单条 GROUP BY 语句，由 idx_game_records_stats 覆盖
+ */
+QList<ModeStats> Database::getPlayerModeStats(const QString& playerId)
+{
+    QList<ModeStats> statsList;
+    
+    QSqlQuery query(connection());
+    query.prepare(R"(
+        SELECT mode, COUNT(*), AVG(score), MAX(score), MAX(max_combo)
+        FROM game_records
+        WHERE player_id = ?
+        GROUP BY mode
+        ORDER BY mode
+    )");
+    query.addBindValue(playerId);
+    
+    if (!query.exec()) {
+        qCritical() << "Failed to get player mode stats:" << query.lastError().text();
+        return statsList;
+    }
+    
+    while (query.next()) {
+        ModeStats stats;
+        stats.mode = query.value(0).toString();
+        stats.games = query.value(1).toInt();
+        stats.averageScore = query.value(2).toDouble();
+        stats.bestScore = query.value(3).toInt();
+        stats.bestCombo = query.value(4).toInt();
+        statsList.append(stats);
+    }
+    
+    return statsList;
+}
+
 /**
  * @brief 获取玩家总游戏局数
  */
 int Database::getTotalGamesPlayed(const QString& playerId)
 {
-    QSqlQuery query(db_);
+    QSqlDatabase db = connection();
+    QSqlQuery query(db);
     query.prepare("SELECT COUNT(*) FROM game_records WHERE player_id = ?");
     query.addBindValue(playerId);
     
@@ -682,7 +1389,8 @@ int Database::getTotalGamesPlayed(const QString& playerId)
  */
 int Database::getHighestScore(const QString& playerId)
 {
-    QSqlQuery query(db_);
+    QSqlDatabase db = connection();
+    QSqlQuery query(db);
     query.prepare("SELECT MAX(score) FROM game_records WHERE player_id = ?");
     query.addBindValue(playerId);
     
@@ -698,7 +1406,8 @@ int Database::getHighestScore(const QString& playerId)
  */
 int Database::getCompletedAchievementCount(const QString& playerId)
 {
-    QSqlQuery query(db_);
+    QSqlDatabase db = connection();
+    QSqlQuery query(db);
     query.prepare(R"(
         SELECT COUNT(*) FROM achievement_progress
         WHERE player_id = ? AND state >= ?
@@ -2,9 +2,16 @@
 #define DATABASE_H
 
 #include <QSqlDatabase>
+#include <QSqlQuery>
 #include <QString>
+#include <QByteArray>
+#include <QMutex>
+#include <QStringList>
+#include <QHash>
 #include <QDateTime>
 #include <memory>
+#include <functional>
+
 
 /**
  * @brief 成就完成状态
@@ -42,6 +49,7 @@ struct AchievementProgress {
  * @brief 游戏记录数据
  */
 struct GameRecord {
+    qint64 recordId = 0;     // 记录ID（分页游标用）
     QString playerId;        // 玩家ID
     QString mode;            // 游戏模式
     int score;               // 得分
@@ -49,6 +57,28 @@ struct GameRecord {
     QDateTime playedAt;      // 游戏时间
 };
 
+/**
+ * @brief 历史记录分页游标（键集分页，按 (played_at, id) 倒序）
+ * 
+ * 默认构造的游标表示从最新一条开始；翻页时传入上一页返回的游标
+ */
+struct RecordCursor {
+    QString playedAt;        // 上一页最后一条的时间
+    qint64 id = 0;           // 上一页最后一条的ID（0表示从头开始/没有更多）
+    bool atEnd() const { return id == 0; }
+};
+
+/**
+ * @brief 玩家按模式汇总的统计
+ */
+struct ModeStats {
+    QString mode;            // 游戏模式
+    int games = 0;           // 局数
+    double averageScore = 0; // 平均分
+    int bestScore = 0;       // 最高分
+    int bestCombo = 0;       // 最大连击
+};
+
 /**
  * @brief 数据库管理类
  * 
@@ -65,6 +95,39 @@ public:
     bool initialize(const QString& dbPath = "fruitcrush.db");
     void close();
     
+    // 当前线程的连接（每个线程一个命名连接，指向同一数据库文件）
+    QSqlDatabase connection();
+    
+    /**
+     * @brief 高频语句ID（每个连接各缓存一份预编译语句）
+     */
+    enum class Statement {
+        GET_PLAYER_SCORE,
+        SAVE_PLAYER_SCORE,
+        GET_PLAYER_PROPS,
+        SAVE_PLAYER_PROPS,
+        GET_ACHIEVEMENT_PROGRESS,
+        GET_ALL_ACHIEVEMENT_PROGRESS,
+        UPDATE_ACHIEVEMENT_PROGRESS,
+        ADVANCE_ACHIEVEMENT_PROGRESS,   // 批量写回：只推进不回退
+        COMPLETE_LOCKED_ACHIEVEMENT,    // 批量写回：未完成→已完成
+        GET_LEADERBOARD,
+        INSERT_COMPETITION_RECORD,
+        UPSERT_COMPETITION_BEST,
+        GET_PLAYER_BEST_SCORE,
+        COUNT_PLAYERS_ABOVE,
+        UPSERT_WINDOW_BEST,
+        GET_WINDOW_LEADERBOARD,
+        GET_WINDOW_PLAYER_BEST,
+        COUNT_WINDOW_PLAYERS_ABOVE,
+        PAGE_GAME_RECORDS,
+        PAGE_COMPETITION_RECORDS,
+        COUNT
+    };
+    
+    // 取当前线程连接上已预编译的语句（首次使用时以 sql 预编译）
+    QSqlQuery& statement(Statement id, const char* sql);
+    
     // 玩家数据操作
     bool createPlayer(const QString& playerId, const QString& username);
     PlayerData getPlayer(const QString& playerId);
@@ -86,6 +149,10 @@ public:
     PropData getPlayerProps(const QString& playerId);  // 获取玩家道具数量
     bool savePlayerProps(const QString& playerId, int hammer, int clamp, int magicWand);  // 保存玩家道具
     
+    // 休闲模式棋盘存档（BoardSerializer 编码的二进制数据）
+    bool saveCasualBoard(const QString& playerId, const QByteArray& board);   // 保存棋盘存档
+    QByteArray loadCasualBoard(const QString& playerId);                     // 读取棋盘存档（无存档返回空）
+    
     // 成就进度操作
     bool initializeAchievements(const QString& playerId);
     AchievementProgress getAchievementProgress(const QString& playerId, const QString& achievementId);
@@ -93,12 +160,28 @@ public:
     bool updateAchievementProgress(const QString& playerId, const QString& achievementId, int currentValue);
     bool completeAchievement(const QString& playerId, const QString& achievementId);
     bool claimAchievementReward(const QString& playerId, const QString& achievementId, int reward);
+    bool saveAchievementProgressBatch(const QString& playerId, const QList<AchievementProgress>& progressList);  // 单事务批量写入进度/完成状态
     
     // 游戏记录操作
     bool saveGameRecord(const GameRecord& record);
     QList<GameRecord> getGameRecords(const QString& playerId, int limit = 10);
     
+    /**
+     * @brief 逐条读取一页游戏记录（不构造列表，适合流式展示大量历史）
+     * @param playerId 玩家ID
+     * @param after 上一页返回的游标（默认从最新开始）
+     * @param pageSize 本页最多读取条数
+     * @param visitor 每条记录的回调
+     * @return 下一页游标（atEnd() 表示没有更多记录）
+     */
+    RecordCursor forEachGameRecord(const QString& playerId, const RecordCursor& after, int pageSize,
+                                   const std::function<void(const GameRecord&)>& visitor);
+    
+    // 按 competition_records 重建排行榜汇总表（批量导入后调用，调用方负责事务）
+    bool rebuildCompetitionAggregates();
+    
     // 统计查询
+    QList<ModeStats> getPlayerModeStats(const QString& playerId);  // 按模式汇总（单条语句）
     int getTotalGamesPlayed(const QString& playerId);
     int getHighestScore(const QString& playerId);
     int getCompletedAchievementCount(const QString& playerId);
@@ -109,10 +192,30 @@ private:
     Database(const Database&) = delete;
     Database& operator=(const Database&) = delete;
     
-    bool createTables();
+    bool createTables();                 // 执行未应用的结构迁移
     bool tableExists(const QString& tableName);
+    int schemaVersion();
+    bool columnExists(QSqlQuery& query, const QString& tableName, const QString& columnName);
+    
+    // 结构迁移（按版本号顺序，只追加不修改）
+    bool migrateV1BaseTables(QSqlQuery& query);
+    bool migrateV2PlayerPropColumns(QSqlQuery& query);
+    bool migrateV3CompetitionBest(QSqlQuery& query);
+    bool migrateV4WindowBest(QSqlQuery& query);
+    bool migrateV5HistoryIndexes(QSqlQuery& query);
+    bool backfillCompetitionBest(QSqlQuery& query);
+    bool backfillWindowBest(QSqlQuery& query);
+    bool openConnection(QSqlDatabase& db);
+    void releaseConnection(const QString& name);
     
-    QSqlDatabase db_;
+    QString dbPath_;                 // 数据库文件路径（各线程连接共用）
+    QMutex poolMutex_;               // 保护 connectionNames_
+    QStringList connectionNames_;    // 已创建的线程连接名
+    
+    struct StatementCache {
+        std::unique_ptr<QSqlQuery> statements[static_cast<int>(Statement::COUNT)];
+    };
+    QHash<QString, StatementCache*> statementCaches_;  // 连接名 → 预编译语句（受 poolMutex_ 保护）
     QString currentPlayerId_;  // 当前玩家ID（会话级别）
 };
 
@@ -0,0 +1,226 @@
+#include "PersistenceWorker.h"
+#include "Database.h"
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QMutexLocker>
+#include <QDebug>
+
+thread_local QList<CommitCallback>* PersistenceWorker::currentCallbacks_ = nullptr;
+
+PersistenceWorker& PersistenceWorker::instance()
+{
+    static PersistenceWorker instance;
+    return instance;
+}
+
+PersistenceWorker::PersistenceWorker()
+{
+    setObjectName("PersistenceWorker");
+}
+
+PersistenceWorker::~PersistenceWorker()
+{
+    shutdown();
+}
+
+/**
+ * @brief 启动持久化线程
+ */
+void PersistenceWorker::startWorker()
+{
+    if (isRunning()) {
+        return;
+    }
+
+    {
+        QMutexLocker locker(&mutex_);
+        stopping_ = false;
+    }
+    start();
+}
+
+/**
+ * @brief 停止持久化线程（队列中剩余命令会先写完）
+ */
+void PersistenceWorker::shutdown()
+{
+    if (!isRunning()) {
+        return;
+    }
+
+    {
+        QMutexLocker locker(&mutex_);
+        stopping_ = true;
+        queueNotEmpty_.wakeAll();
+    }
+    wait();
+}
+
+QFuture<bool> PersistenceWorker::submit(const PersistenceCommand& command)
+{
+    return submit(QList<PersistenceCommand>{command});
+}
+
+/**
+ * @brief 提交一组写命令
+ *
+ * 线程运行中：入队并立即返回；否则在调用线程同步执行（返回已完成的 future）
+ */
+QFuture<bool> PersistenceWorker::submit(const QList<PersistenceCommand>& commands)
+{
+    PendingGroup group;
+    group.commands = commands;
+    group.promise = std::make_shared<QPromise<bool>>();
+    group.promise->start();
+    QFuture<bool> future = group.promise->future();
+
+    {
+        QMutexLocker locker(&mutex_);
+        if (isRunning() && !stopping_) {
+            queue_.append(group);
+            queueNotEmpty_.wakeOne();
+            return future;
+        }
+    }
+
+    QList<PendingGroup> batch;
+    batch.append(group);
+    executeBatch(batch);
+    return future;
+}
+
+/**
+ * @brief 线程主循环：每次取走队列中的全部命令组，合并为一个事务
+ */
+void PersistenceWorker::run()
+{
+    while (true) {
+        QList<PendingGroup> batch;
+        {
+            QMutexLocker locker(&mutex_);
+            while (queue_.isEmpty() && !stopping_) {
+                queueNotEmpty_.wait(&mutex_);
+            }
+            if (queue_.isEmpty() && stopping_) {
+                break;
+            }
+            batch.swap(queue_);
+            inFlight_ = batch.size();
+        }
+
+        executeBatch(batch);
+
+        {
+            QMutexLocker locker(&mutex_);
+            inFlight_ = 0;
+            if (queue_.isEmpty()) {
+                idle_.wakeAll();
+            }
+        }
+    }
+}
+
+/**
+ * @brief 阻塞等待队列清空（线程未运行时直接返回）
+ */
+void PersistenceWorker::waitForPending()
+{
+    QMutexLocker locker(&mutex_);
+    while (isRunning() && (!queue_.isEmpty() || inFlight_ > 0)) {
+        idle_.wait(&mutex_);
+    }
+}
+
+/**
+ * @brief 此前提交的命令全部落盘后完成
+ *
+ * 批次按提交顺序执行，排在队尾的空命令组完成时，之前的命令组都已提交或回滚
+ */
+QFuture<bool> PersistenceWorker::whenFlushed()
+{
+    return submit(QList<PersistenceCommand>{});
+}
+
+/**
+ * @brief 注册当前命令组的提交回调
+ */
+void PersistenceWorker::afterCommit(const CommitCallback& callback)
+{
+    if (!callback) {
+        return;
+    }
+    if (currentCallbacks_) {
+        currentCallbacks_->append(callback);
+    } else {
+        callback(true);
+    }
+}
+
+/**
+ * @brief 在一个事务中执行一批命令组，提交后再完成各自的 future
+ */
+void PersistenceWorker::executeBatch(QList<PendingGroup>& batch)
+{
+    QSqlDatabase db = Database::instance().connection();
+    QList<bool> results;
+    results.reserve(batch.size());
+    QList<QList<CommitCallback>> callbacks;
+    callbacks.reserve(batch.size());
+
+    // 1. 开启事务（失败时退化为每组自动提交）
+    const bool inTransaction = db.transaction();
+    if (!inTransaction) {
+        qWarning() << "Failed to begin persistence batch:" << db.lastError().text();
+    }
+
+    // 2. 每组一个 SAVEPOINT，失败只回滚本组
+    QSqlQuery savepoint(db);
+    for (const auto& group : batch) {
+        savepoint.exec("SAVEPOINT persistence_group");
+        QList<CommitCallback> groupCallbacks;
+        const bool ok = executeGroup(group, groupCallbacks);
+        if (!ok) {
+            savepoint.exec("ROLLBACK TO SAVEPOINT persistence_group");
+        }
+        savepoint.exec("RELEASE SAVEPOINT persistence_group");
+        results.append(ok);
+        callbacks.append(groupCallbacks);
+    }
+
+    // 3. 提交（整批一次 fsync）
+    if (inTransaction && !db.commit()) {
+        qCritical() << "Failed to commit persistence batch:" << db.lastError().text();
+        db.rollback();
+        for (int i = 0; i < results.size(); ++i) {
+            results[i] = false;
+        }
+    }
+
+    // 4. 事务结束后执行提交回调（回滚的组以 false 通知）
+    for (int i = 0; i < batch.size(); ++i) {
+        for (const auto& callback : callbacks[i]) {
+            callback(results[i]);
+        }
+    }
+
+    // 5. 写入落盘后再通知调用方
+    for (int i = 0; i < batch.size(); ++i) {
+        batch[i].promise->addResult(results[i]);
+        batch[i].promise->finish();
+    }
+}
+
+bool PersistenceWorker::executeGroup(const PendingGroup& group, QList<CommitCallback>& callbacks)
+{
+    currentCallbacks_ = &callbacks;
+    bool ok = true;
+    for (const auto& command : group.commands) {
+        if (command && !command()) {
+            ok = false;
+            break;
+        }
+    }
+    currentCallbacks_ = nullptr;
+    return ok;
+}
@@ -0,0 +1,116 @@
+#ifndef PERSISTENCEWORKER_H
+#define PERSISTENCEWORKER_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QList>
+#include <QFuture>
+#include <QPromise>
+#include <functional>
+#include <memory>
+
+/**
+ * @brief 写命令（在持久化线程上执行，返回是否成功）
+ *
+ * 命令内部直接调用 Database / RankManager 的接口即可，
+ * 它们会自动使用持久化线程自己的数据库连接。
+ * 命令已处于批次事务中，不能再自行调用 transaction()。
+ */
+using PersistenceCommand = std::function<bool()>;
+
+/**
+ * @brief 提交回调（参数为命令组的写入是否已经提交到数据库）
+ */
+using CommitCallback = std::function<void(bool committed)>;
+
+/**
+ * @brief 异步持久化线程（write-behind）
+ *
+ * 负责：
+ * - 接收主线程提交的写命令组，立即返回 QFuture
+ * - 把队列中所有待写的命令组合并到一个事务中提交（一次 fsync）
+ * - 每个命令组使用独立的 SAVEPOINT，一组失败不影响同批次的其他组
+ * - 命令可通过 afterCommit 注册回调，在整批提交（或回滚）之后执行，
+ *   用于只在数据真正落盘后才更新的内存缓存
+ *
+ * 未启动（或已关闭）时提交的命令在调用线程上同步执行。
+ */
+class PersistenceWorker : public QThread {
+    Q_OBJECT
+
+public:
+    static PersistenceWorker& instance();
+
+    /**
+     * @brief 启动持久化线程（数据库初始化之后调用）
+     */
+    void startWorker();
+
+    /**
+     * @brief 写完队列中剩余命令并停止线程（关闭数据库之前调用）
+     */
+    void shutdown();
+
+    /**
+     * @brief 提交一组写命令，整组在同一个 SAVEPOINT 内执行
+     * @param commands 写命令列表（按顺序执行）
+     * @return 整组是否全部成功
+     */
+    QFuture<bool> submit(const QList<PersistenceCommand>& commands);
+
+    /**
+     * @brief 提交单条写命令
+     */
+    QFuture<bool> submit(const PersistenceCommand& command);
+
+    /**
+     * @brief 等待已提交的命令全部落盘（读取刚写入的数据之前调用）
+     *
+     * 会阻塞调用线程，界面线程应改用 whenFlushed。
+     */
+    void waitForPending();
+
+    /**
+     * @brief 返回一个在此前提交的命令全部落盘后完成的 future（不阻塞）
+     *
+     * 界面线程读取刚写入的数据时，用 then(context, ...) 把读取接在它后面。
+     */
+    QFuture<bool> whenFlushed();
+
+    /**
+     * @brief 在当前命令组提交或回滚之后执行回调（在写命令内部调用）
+     *
+     * 不在命令组中调用时（直接写入、自动提交）立即以 true 执行。
+     * 回调在执行批次的线程上调用，此时事务已结束。
+     */
+    static void afterCommit(const CommitCallback& callback);
+
+protected:
+    void run() override;
+
+private:
+    PersistenceWorker();
+    ~PersistenceWorker();
+    PersistenceWorker(const PersistenceWorker&) = delete;
+    PersistenceWorker& operator=(const PersistenceWorker&) = delete;
+
+    struct PendingGroup {
+        QList<PersistenceCommand> commands;          ///< 写命令
+        std::shared_ptr<QPromise<bool>> promise;     ///< 完成通知
+    };
+
+    void executeBatch(QList<PendingGroup>& batch);   ///< 单事务执行一批命令组
+    static bool executeGroup(const PendingGroup& group, QList<CommitCallback>& callbacks);
+
+    static thread_local QList<CommitCallback>* currentCallbacks_;  ///< 正在执行的命令组的提交回调
+
+    QMutex mutex_;                    ///< 保护 queue_ / stopping_
+    QWaitCondition queueNotEmpty_;    ///< 有新命令或需要停止
+    QWaitCondition idle_;             ///< 队列与当前批次均已写完
+    int inFlight_ = 0;                ///< 正在执行的命令组数
+    QList<PendingGroup> queue_;       ///< 待写命令组
+    bool stopping_ = false;           ///< 是否请求停止
+};
+
+#endif // PERSISTENCEWORKER_H
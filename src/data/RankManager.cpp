@@ -1,9 +1,12 @@
 ﻿#include "RankManager.h"
 #include "Database.h"
+#include "PersistenceWorker.h"
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QDebug>
 #include <QVariant>
+#include <QMutexLocker>
+#include <limits>
 
 RankManager& RankManager::instance()
 {
@@ -33,47 +36,248 @@ QString RankManager::durationToString(CompetitionDuration duration)
     }
 }
 
+int RankManager::durationIndex(CompetitionDuration duration)
+{
+    switch (duration) {
+        case CompetitionDuration::SECONDS_120:
+            return 1;
+        case CompetitionDuration::SECONDS_180:
+            return 2;
+        case CompetitionDuration::SECONDS_60:
+        default:
+            return 0;
+    }
+}
+
 bool RankManager::recordScore(const QString& playerId, 
                                const QString& playerName,
                                int score, 
                                int maxCombo,
                                CompetitionDuration duration)
 {
-    QSqlQuery query;
-    query.prepare(R"(
+    Database& db = Database::instance();
+    const QString durationType = durationToString(duration);
+    // 结束时间与日/周/赛季分桶取自同一次时钟读取（跨零点时两者一致）
+    const QDateTime now = QDateTime::currentDateTime();
+    const QString playedAt = now.toString(Qt::ISODate);
+    
+    // 历史记录与最佳成绩在同一个 SAVEPOINT 内更新
+    // （用 SAVEPOINT 而不是 transaction()，在持久化线程的批次事务中也能嵌套使用）
+    QSqlQuery savepoint(db.connection());
+    if (!savepoint.exec("SAVEPOINT record_score")) {
+        qCritical() << "Failed to begin record_score:" << savepoint.lastError().text();
+        return false;
+    }
+    
+    // 1. 历史记录
+    QSqlQuery& insertQuery = db.statement(Database::Statement::INSERT_COMPETITION_RECORD, R"(
         INSERT INTO competition_records 
         (player_id, player_name, score, max_combo, duration_type, played_at)
         VALUES (?, ?, ?, ?, ?, ?)
     )");
     
-    query.addBindValue(playerId);
-    query.addBindValue(playerName);
-    query.addBindValue(score);
-    query.addBindValue(maxCombo);
-    query.addBindValue(durationToString(duration));
-    query.addBindValue(QDateTime::currentDateTime().toString(Qt::ISODate));
+    insertQuery.addBindValue(playerId);
+    insertQuery.addBindValue(playerName);
+    insertQuery.addBindValue(score);
+    insertQuery.addBindValue(maxCombo);
+    insertQuery.addBindValue(durationType);
+    insertQuery.addBindValue(playedAt);
     
-    if (!query.exec()) {
-        qCritical() << "Failed to record competition score:" << query.lastError().text();
+    if (!insertQuery.exec()) {
+        qCritical() << "Failed to record competition score:" << insertQuery.lastError().text();
+        savepoint.exec("ROLLBACK TO SAVEPOINT record_score");
+        savepoint.exec("RELEASE SAVEPOINT record_score");
+        return false;
+    }
+    
+    // 2. 最佳成绩（只在严格更高时覆盖，同分保留先达成的）
+    QSqlQuery& bestQuery = db.statement(Database::Statement::UPSERT_COMPETITION_BEST, R"(
+        INSERT INTO competition_best
+        (player_id, duration_type, player_name, best_score, max_combo, played_at)
+        VALUES (?, ?, ?, ?, ?, ?)
+        ON CONFLICT(player_id, duration_type) DO UPDATE SET
+            player_name = excluded.player_name,
+            best_score = excluded.best_score,
+            max_combo = excluded.max_combo,
+            played_at = excluded.played_at
+        WHERE excluded.best_score > competition_best.best_score
+    )");
+    
+    bestQuery.addBindValue(playerId);
+    bestQuery.addBindValue(durationType);
+    bestQuery.addBindValue(playerName);
+    bestQuery.addBindValue(score);
+    bestQuery.addBindValue(maxCombo);
+    bestQuery.addBindValue(playedAt);
+    
+    if (!bestQuery.exec()) {
+        qCritical() << "Failed to update competition best:" << bestQuery.lastError().text();
+        savepoint.exec("ROLLBACK TO SAVEPOINT record_score");
+        savepoint.exec("RELEASE SAVEPOINT record_score");
+        return false;
+    }
+    
+    // 3. 日/周/赛季分桶最佳成绩
+    QSqlQuery& windowQuery = db.statement(Database::Statement::UPSERT_WINDOW_BEST, R"(
+        INSERT INTO competition_window_best
+        (window_type, bucket, duration_type, player_id, player_name, best_score, max_combo, played_at)
+        VALUES (?, ?, ?, ?, ?, ?, ?, ?)
+        ON CONFLICT(window_type, bucket, duration_type, player_id) DO UPDATE SET
+            player_name = excluded.player_name,
+            best_score = excluded.best_score,
+            max_combo = excluded.max_combo,
+            played_at = excluded.played_at
+        WHERE excluded.best_score > competition_window_best.best_score
+    )");
+    
+    static const LeaderboardWindow kWindows[] = {
+        LeaderboardWindow::DAILY, LeaderboardWindow::WEEKLY, LeaderboardWindow::SEASON
+    };
+    const QDate today = now.date();
+    for (LeaderboardWindow window : kWindows) {
+        windowQuery.addBindValue(static_cast<int>(window));
+        windowQuery.addBindValue(windowBucket(window, today));
+        windowQuery.addBindValue(durationType);
+        windowQuery.addBindValue(playerId);
+        windowQuery.addBindValue(playerName);
+        windowQuery.addBindValue(score);
+        windowQuery.addBindValue(maxCombo);
+        windowQuery.addBindValue(playedAt);
+        
+        if (!windowQuery.exec()) {
+            qCritical() << "Failed to update window best:" << windowQuery.lastError().text();
+            savepoint.exec("ROLLBACK TO SAVEPOINT record_score");
+            savepoint.exec("RELEASE SAVEPOINT record_score");
+            return false;
+        }
+    }
+    
+    if (!savepoint.exec("RELEASE SAVEPOINT record_score")) {
+        qCritical() << "Failed to commit record_score:" << savepoint.lastError().text();
+        savepoint.exec("ROLLBACK TO SAVEPOINT record_score");
+        savepoint.exec("RELEASE SAVEPOINT record_score");
         return false;
     }
     
+    // 4. 上榜成绩在批次事务提交后才原地更新缓存；回滚时丢弃缓存，下次读取重新加载
+    RankRecord record;
+    record.playerId = playerId;
+    record.playerName = playerName;
+    record.score = score;
+    record.maxCombo = maxCombo;
+    record.duration = duration;
+    record.playedAt = QDateTime::fromString(playedAt, Qt::ISODate);
+    
+    PersistenceWorker::afterCommit([this, record](bool committed) {
+        if (committed) {
+            QMutexLocker locker(&cacheMutex_);
+            applyToCache(record);
+        } else {
+            invalidateLeaderboardCache();
+        }
+    });
+    
     qDebug() << "Competition score recorded:" << playerName << score << "points in" 
              << CompetitionMode::getDurationString(duration);
     return true;
 }
 
+/**
+ * @brief 新成绩写入后原地更新缓存
+ * 
+ * 与 competition_best 的规则一致：每个玩家一行，只有严格更高分才替换，
+ * 同分按时间先后排列（新成绩排在同分者之后）
+ */
+void RankManager::applyToCache(const RankRecord& record)
+{
+    LeaderboardCache& cache = caches_[durationIndex(record.duration)];
+    if (!cache.loaded) {
+        return;  // 尚未加载，下次读取时直接从数据库取
+    }
+    
+    QList<RankRecord>& records = cache.records;
+    
+    // 1. 玩家已在榜上：未超过原最佳则不变，否则先移除旧记录
+    for (int i = 0; i < records.size(); ++i) {
+        if (records[i].playerId == record.playerId) {
+            if (record.score <= records[i].score) {
+                return;
+            }
+            records.removeAt(i);
+            break;
+        }
+    }
+    
+    // 2. 找插入位置
+    int pos = 0;
+    while (pos < records.size() && records[pos].score >= record.score) {
+        ++pos;
+    }
+    if (pos >= LEADERBOARD_CACHE_SIZE) {
+        return;  // 未进入前 N 名
+    }
+    
+    records.insert(pos, record);
+    while (records.size() > LEADERBOARD_CACHE_SIZE) {
+        records.removeLast();
+    }
+    
+    // 3. 重新编号
+    for (int i = pos; i < records.size(); ++i) {
+        records[i].rank = i + 1;
+    }
+    
+    ++cache.version;
+}
+
+void RankManager::invalidateLeaderboardCache()
+{
+    QMutexLocker locker(&cacheMutex_);
+    for (auto& cache : caches_) {
+        cache.loaded = false;
+        cache.records.clear();
+        ++cache.version;
+    }
+}
+
+quint64 RankManager::getLeaderboardVersion(CompetitionDuration duration) const
+{
+    QMutexLocker locker(&cacheMutex_);
+    return caches_[durationIndex(duration)].version;
+}
+
 QList<RankRecord> RankManager::getLeaderboard(CompetitionDuration duration, int limit)
 {
-    QList<RankRecord> records;
+    if (limit > LEADERBOARD_CACHE_SIZE) {
+        QList<RankRecord> records;
+        queryLeaderboard(duration, limit, records);
+        return records;
+    }
     
-    QSqlQuery query;
-    // 按分数降序排列，相同分数按时间升序（先达成的排前面）
-    query.prepare(R"(
-        SELECT player_id, player_name, score, max_combo, played_at
-        FROM competition_records
+    QMutexLocker locker(&cacheMutex_);
+    LeaderboardCache& cache = caches_[durationIndex(duration)];
+    if (!cache.loaded) {
+        QList<RankRecord> records;
+        if (!queryLeaderboard(duration, LEADERBOARD_CACHE_SIZE, records)) {
+            return records;  // 查询失败不缓存，下次重试
+        }
+        cache.records = records;
+        cache.loaded = true;
+        ++cache.version;
+    }
+    
+    return cache.records.mid(0, limit);
+}
+
+bool RankManager::queryLeaderboard(CompetitionDuration duration, int limit, QList<RankRecord>& records)
+{
+    
+    // 每个玩家取最佳成绩，按分数降序排列，相同分数按时间升序（先达成的排前面）
+    QSqlQuery& query = Database::instance().statement(Database::Statement::GET_LEADERBOARD, R"(
+        SELECT player_id, player_name, best_score, max_combo, played_at
+        FROM competition_best
         WHERE duration_type = ?
-        ORDER BY score DESC, played_at ASC
+        ORDER BY best_score DESC, played_at ASC
         LIMIT ?
     )");
     
@@ -82,7 +286,7 @@ QList<RankRecord> RankManager::getLeaderboard(CompetitionDuration duration, int
     
     if (!query.exec()) {
         qCritical() << "Failed to get leaderboard:" << query.lastError().text();
-        return records;
+        return false;
     }
     
     int rank = 1;
@@ -97,8 +301,9 @@ QList<RankRecord> RankManager::getLeaderboard(CompetitionDuration duration, int
         record.playedAt = QDateTime::fromString(query.value(4).toString(), Qt::ISODate);
         records.append(record);
     }
+    query.finish();
     
-    return records;
+    return true;
 }
 
 int RankManager::getPlayerRank(const QString& playerId, CompetitionDuration duration)
@@ -109,12 +314,11 @@ int RankManager::getPlayerRank(const QString& playerId, CompetitionDuration dura
         return 0;
     }
     
-    // 计算有多少玩家分数高于该玩家的最高分
-    QSqlQuery query;
-    query.prepare(R"(
-        SELECT COUNT(DISTINCT player_id) 
-        FROM competition_records 
-        WHERE duration_type = ? AND score > ?
+    // 计算有多少玩家的最佳成绩高于该玩家（覆盖索引上的范围计数）
+    QSqlQuery& query = Database::instance().statement(Database::Statement::COUNT_PLAYERS_ABOVE, R"(
+        SELECT COUNT(*) 
+        FROM competition_best 
+        WHERE duration_type = ? AND best_score > ?
     )");
     
     query.addBindValue(durationToString(duration));
@@ -125,27 +329,30 @@ int RankManager::getPlayerRank(const QString& playerId, CompetitionDuration dura
         return 0;
     }
     
-    return query.value(0).toInt() + 1;
+    const int rank = query.value(0).toInt() + 1;
+    query.finish();
+    return rank;
 }
 
 int RankManager::getPlayerBestScore(const QString& playerId, CompetitionDuration duration)
 {
-    QSqlQuery query;
-    query.prepare(R"(
-        SELECT MAX(score) 
-        FROM competition_records 
+    QSqlQuery& query = Database::instance().statement(Database::Statement::GET_PLAYER_BEST_SCORE, R"(
+        SELECT best_score 
+        FROM competition_best 
         WHERE player_id = ? AND duration_type = ?
     )");
     
     query.addBindValue(playerId);
     query.addBindValue(durationToString(duration));
     
-    if (!query.exec() || !query.next()) {
+    if (!query.exec()) {
         qCritical() << "Failed to get player best score:" << query.lastError().text();
         return 0;
     }
     
-    return query.value(0).toInt();
+    const int bestScore = query.next() ? query.value(0).toInt() : 0;
+    query.finish();
+    return bestScore;
 }
 
 bool RankManager::isPersonalBest(const QString& playerId, int score, CompetitionDuration duration)
@@ -156,7 +363,7 @@ bool RankManager::isPersonalBest(const QString& playerId, int score, Competition
 
 int RankManager::getTotalGames(CompetitionDuration duration)
 {
-    QSqlQuery query;
+    QSqlQuery query(Database::instance().connection());
     query.prepare(R"(
         SELECT COUNT(*) 
         FROM competition_records 
@@ -172,3 +379,173 @@ int RankManager::getTotalGames(CompetitionDuration duration)
     
     return query.value(0).toInt();
 }
+
+qint64 RankManager::windowBucket(LeaderboardWindow window, const QDate& date)
+{
+    static const qint64 EPOCH_JULIAN_DAY = QDate(1970, 1, 1).toJulianDay();
+    const qint64 day = date.toJulianDay() - EPOCH_JULIAN_DAY;
+    
+    switch (window) {
+        case LeaderboardWindow::DAILY:
+            return day;
+        case LeaderboardWindow::WEEKLY:
+            return (day + 3) / 7;  // 1970-01-01 是周四，+3 使每周从周一开始
+        case LeaderboardWindow::SEASON:
+            return day / SEASON_LENGTH_DAYS;
+        case LeaderboardWindow::ALL_TIME:
+        default:
+            return 0;
+    }
+}
+
+QList<RankRecord> RankManager::getLeaderboard(CompetitionDuration duration, LeaderboardWindow window, int limit)
+{
+    if (window == LeaderboardWindow::ALL_TIME) {
+        return getLeaderboard(duration, limit);
+    }
+    
+    QList<RankRecord> records;
+    
+    // 当前桶内每个玩家一行，按覆盖索引顺序直接取前 limit 条
+    QSqlQuery& query = Database::instance().statement(Database::Statement::GET_WINDOW_LEADERBOARD, R"(
+        SELECT player_id, player_name, best_score, max_combo, played_at
+        FROM competition_window_best
+        WHERE window_type = ? AND bucket = ? AND duration_type = ?
+        ORDER BY best_score DESC, played_at ASC
+        LIMIT ?
+    )");
+    
+    query.addBindValue(static_cast<int>(window));
+    query.addBindValue(windowBucket(window, QDate::currentDate()));
+    query.addBindValue(durationToString(duration));
+    query.addBindValue(limit);
+    
+    if (!query.exec()) {
+        qCritical() << "Failed to get window leaderboard:" << query.lastError().text();
+        return records;
+    }
+    
+    int rank = 1;
+    while (query.next()) {
+        RankRecord record;
+        record.rank = rank++;
+        record.playerId = query.value(0).toString();
+        record.playerName = query.value(1).toString();
+        record.score = query.value(2).toInt();
+        record.maxCombo = query.value(3).toInt();
+        record.duration = duration;
+        record.playedAt = QDateTime::fromString(query.value(4).toString(), Qt::ISODate);
+        records.append(record);
+    }
+    query.finish();
+    
+    return records;
+}
+
+int RankManager::getPlayerRank(const QString& playerId, CompetitionDuration duration, LeaderboardWindow window)
+{
+    if (window == LeaderboardWindow::ALL_TIME) {
+        return getPlayerRank(playerId, duration);
+    }
+    
+    Database& db = Database::instance();
+    const qint64 bucket = windowBucket(window, QDate::currentDate());
+    const QString durationType = durationToString(duration);
+    
+    // 1. 本窗口内的最佳成绩（主键查找）
+    QSqlQuery& bestQuery = db.statement(Database::Statement::GET_WINDOW_PLAYER_BEST, R"(
+        SELECT best_score
+        FROM competition_window_best
+        WHERE window_type = ? AND bucket = ? AND duration_type = ? AND player_id = ?
+    )");
+    
+    bestQuery.addBindValue(static_cast<int>(window));
+    bestQuery.addBindValue(bucket);
+    bestQuery.addBindValue(durationType);
+    bestQuery.addBindValue(playerId);
+    
+    if (!bestQuery.exec()) {
+        qCritical() << "Failed to get window best score:" << bestQuery.lastError().text();
+        return 0;
+    }
+    
+    const bool hasScore = bestQuery.next();
+    const int bestScore = hasScore ? bestQuery.value(0).toInt() : 0;
+    bestQuery.finish();
+    if (!hasScore) {
+        return 0;
+    }
+    
+    // 2. 本窗口内成绩更高的玩家数（覆盖索引上的范围计数）
+    QSqlQuery& countQuery = db.statement(Database::Statement::COUNT_WINDOW_PLAYERS_ABOVE, R"(
+        SELECT COUNT(*)
+        FROM competition_window_best
+        WHERE window_type = ? AND bucket = ? AND duration_type = ? AND best_score > ?
+    )");
+    
+    countQuery.addBindValue(static_cast<int>(window));
+    countQuery.addBindValue(bucket);
+    countQuery.addBindValue(durationType);
+    countQuery.addBindValue(bestScore);
+    
+    if (!countQuery.exec() || !countQuery.next()) {
+        qCritical() << "Failed to get window rank:" << countQuery.lastError().text();
+        return 0;
+    }
+    
+    const int rank = countQuery.value(0).toInt() + 1;
+    countQuery.finish();
+    return rank;
+}
+
+RecordCursor RankManager::forEachRecord(const QString& playerId, CompetitionDuration duration,
+                                        const RecordCursor& after, int pageSize,
+                                        const std::function<void(const RankRecord&)>& visitor)
+{
+    RecordCursor next;
+    
+    QSqlQuery& query = Database::instance().statement(Database::Statement::PAGE_COMPETITION_RECORDS, R"(
+        SELECT id, player_name, score, max_combo, played_at
+        FROM competition_records
+        WHERE player_id = ? AND duration_type = ? AND (played_at, id) < (?, ?)
+        ORDER BY played_at DESC, id DESC
+        LIMIT ?
+    )");
+    
+    query.addBindValue(playerId);
+    query.addBindValue(durationToString(duration));
+    // 起始页用比任何 ISO 时间都大的哨兵
+    query.addBindValue(after.atEnd() ? QString("9999") : after.playedAt);
+    query.addBindValue(after.atEnd() ? std::numeric_limits<qint64>::max() : after.id);
+    query.addBindValue(pageSize);
+    
+    if (!query.exec()) {
+        qCritical() << "Failed to page competition records:" << query.lastError().text();
+        return next;
+    }
+    
+    int rows = 0;
+    qint64 lastId = 0;
+    QString lastPlayedAt;
+    RankRecord record;
+    record.playerId = playerId;
+    record.duration = duration;
+    while (query.next()) {
+        lastId = query.value(0).toLongLong();
+        record.playerName = query.value(1).toString();
+        record.score = query.value(2).toInt();
+        record.maxCombo = query.value(3).toInt();
+        lastPlayedAt = query.value(4).toString();
+        record.playedAt = QDateTime::fromString(lastPlayedAt, Qt::ISODate);
+        visitor(record);
+        ++rows;
+    }
+    query.finish();
+    
+    // 满页才可能还有下一页
+    if (rows == pageSize) {
+        next.playedAt = lastPlayedAt;
+        next.id = lastId;
+    }
+    return next;
+}
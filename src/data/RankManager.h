@@ -4,7 +4,10 @@
 #include <QString>
 #include <QList>
 #include <QDateTime>
+#include <QMutex>
 #include "../mode/CompetitionMode.h"
+#include "Database.h"
+#include <functional>
 
 /**
  * @brief 排行榜记录结构
@@ -19,6 +22,18 @@ struct RankRecord {
     QDateTime playedAt;         ///< 游戏时间
 };
 
+/**
+ * @brief 排行榜统计窗口
+ * 
+ * 数值与 competition_window_best.window_type 一致
+ */
+enum class LeaderboardWindow {
+    ALL_TIME = 0,   ///< 总榜
+    DAILY = 1,      ///< 今日
+    WEEKLY = 2,     ///< 本周（周一起）
+    SEASON = 3      ///< 本赛季（SEASON_LENGTH_DAYS 天一季）
+};
+
 /**
  * @brief 排行榜管理器
  * 
@@ -48,12 +63,65 @@ public:
 
     /**
      * @brief 获取排行榜（指定时长）
+     * 
+     * limit 不超过 LEADERBOARD_CACHE_SIZE 时走内存缓存：首次加载后不再访问数据库，
+     * recordScore 的写入提交后原地更新（回滚则丢弃缓存）
+     * 
      * @param duration 比赛时长类型
      * @param limit 返回数量限制（默认10）
      * @return 排行榜记录列表
      */
     QList<RankRecord> getLeaderboard(CompetitionDuration duration, int limit = 10);
 
+    /**
+     * @brief 排行榜缓存版本号（内容变化时递增，界面据此判断是否需要重绘）
+     * @param duration 比赛时长类型
+     * @return 版本号（0表示尚未加载）
+     */
+    quint64 getLeaderboardVersion(CompetitionDuration duration) const;
+
+    /**
+     * @brief 丢弃排行榜缓存（批量导入等绕过 recordScore 的写入之后调用）
+     */
+    void invalidateLeaderboardCache();
+
+    static const int LEADERBOARD_CACHE_SIZE = 20;  ///< 每种时长缓存的名次数
+
+    /**
+     * @brief 获取指定统计窗口的排行榜（当前日/周/赛季）
+     * @param duration 比赛时长类型
+     * @param window 统计窗口（ALL_TIME 等同于不带窗口的重载）
+     * @param limit 返回数量限制（默认10）
+     * @return 排行榜记录列表
+     */
+    QList<RankRecord> getLeaderboard(CompetitionDuration duration, LeaderboardWindow window, int limit = 10);
+
+    /**
+     * @brief 获取玩家在指定统计窗口的排名
+     * @return 排名（0表示本窗口内无成绩）
+     */
+    int getPlayerRank(const QString& playerId, CompetitionDuration duration, LeaderboardWindow window);
+
+    /**
+     * @brief 计算日期所在的窗口桶号（1970-01-01 起的本地天数换算）
+     */
+    static qint64 windowBucket(LeaderboardWindow window, const QDate& date);
+
+    static const int SEASON_LENGTH_DAYS = 28;      ///< 赛季长度（天）
+
+    /**
+     * @brief 逐条读取玩家的一页比赛记录（键集分页，按时间倒序）
+     * @param playerId 玩家ID
+     * @param duration 比赛时长类型
+     * @param after 上一页返回的游标（默认从最新开始）
+     * @param pageSize 本页最多读取条数
+     * @param visitor 每条记录的回调（rank 字段不填）
+     * @return 下一页游标（atEnd() 表示没有更多记录）
+     */
+    RecordCursor forEachRecord(const QString& playerId, CompetitionDuration duration,
+                               const RecordCursor& after, int pageSize,
+                               const std::function<void(const RankRecord&)>& visitor);
+
     /**
      * @brief 获取玩家在指定时长的排名
      * @param playerId 玩家ID
@@ -96,6 +164,31 @@ private:
      * @brief 将时长枚举转换为数据库字符串
      */
     static QString durationToString(CompetitionDuration duration);
+
+    /**
+     * @brief 时长枚举转换为缓存下标
+     */
+    static int durationIndex(CompetitionDuration duration);
+
+    /**
+     * @brief 从数据库读取前 limit 名（每个玩家取最佳成绩）
+     * @return 查询是否成功
+     */
+    bool queryLeaderboard(CompetitionDuration duration, int limit, QList<RankRecord>& records);
+
+    /**
+     * @brief 新成绩写入后原地更新缓存（调用方持有 cacheMutex_）
+     */
+    void applyToCache(const RankRecord& record);
+
+    struct LeaderboardCache {
+        bool loaded = false;        ///< 是否已从数据库加载
+        QList<RankRecord> records;  ///< 前 LEADERBOARD_CACHE_SIZE 名（已排序）
+        quint64 version = 0;        ///< 内容版本号
+    };
+
+    LeaderboardCache caches_[3];    ///< 60/120/180 秒赛
+    mutable QMutex cacheMutex_;     ///< recordScore 在持久化线程执行，读取在主线程
 };
 
 #endif // RANKMANAGER_H
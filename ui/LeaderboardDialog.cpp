@@ -102,11 +102,19 @@ void LeaderboardDialog::setupTable(QTableWidget* table)
     table->horizontalHeader()->setStretchLastSection(true);
 }
 
-void LeaderboardDialog::loadLeaderboard(QTableWidget* table, CompetitionDuration duration)
+void LeaderboardDialog::loadLeaderboard(QTableWidget* table, CompetitionDuration duration,
+                                        quint64& renderedVersion)
 {
+    // 缓存版本号未变化时表格内容已是最新
+    const quint64 version = RankManager::instance().getLeaderboardVersion(duration);
+    if (version != 0 && version == renderedVersion) {
+        return;
+    }
+    
     table->setRowCount(0);
     
     QList<RankRecord> records = RankManager::instance().getLeaderboard(duration, 10);
+    renderedVersion = RankManager::instance().getLeaderboardVersion(duration);
     
     table->setRowCount(records.size());
     
@@ -163,7 +171,7 @@ void LeaderboardDialog::loadLeaderboard(QTableWidget* table, CompetitionDuration
 
 void LeaderboardDialog::refreshData()
 {
-    loadLeaderboard(table60s_, CompetitionDuration::SECONDS_60);
-    loadLeaderboard(table120s_, CompetitionDuration::SECONDS_120);
-    loadLeaderboard(table180s_, CompetitionDuration::SECONDS_180);
+    loadLeaderboard(table60s_, CompetitionDuration::SECONDS_60, rendered60sVersion_);
+    loadLeaderboard(table120s_, CompetitionDuration::SECONDS_120, rendered120sVersion_);
+    loadLeaderboard(table180s_, CompetitionDuration::SECONDS_180, rendered180sVersion_);
 }
@@ -29,7 +29,7 @@ public:
 private:
     void setupUi();
     void setupTable(QTableWidget* table);
-    void loadLeaderboard(QTableWidget* table, CompetitionDuration duration);
+    void loadLeaderboard(QTableWidget* table, CompetitionDuration duration, quint64& renderedVersion);
 
     QString currentPlayerId_;
     
@@ -37,6 +37,11 @@ private:
     QTableWidget* table60s_;
     QTableWidget* table120s_;
     QTableWidget* table180s_;
+    
+    // 各表绘制时的排行榜缓存版本号（未变化时刷新不重绘）
+    quint64 rendered60sVersion_ = 0;
+    quint64 rendered120sVersion_ = 0;
+    quint64 rendered180sVersion_ = 0;
 };
 
 #endif // LEADERBOARDDIALOG_H
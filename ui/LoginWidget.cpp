@@ -1,5 +1,6 @@
 #include "LoginWidget.h"
 #include "../src/data/Database.h"
+#include "../src/data/PersistenceWorker.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QMessageBox>
@@ -180,7 +181,15 @@ bool LoginWidget::performLogin(const QString& playerId, const QString& playerNam
         // 玩家已存在
         currentPlayerId_ = playerId;
         currentPlayerName_ = player.username;
-        currentPlayerScore_ = Database::instance().getPlayerScore(playerId);
+        currentPlayerScore_ = player.totalPoints;
+        
+        // 上一局的分数可能还在排队写入：落盘后重新读取并刷新显示，不阻塞界面线程
+        PersistenceWorker::instance().whenFlushed().then(this, [this, playerId](bool) {
+            if (currentPlayerId_ == playerId) {
+                currentPlayerScore_ = Database::instance().getPlayerScore(playerId);
+                updatePlayerInfoDisplay();
+            }
+        });
         
         // 确保该玩家的成就已初始化
         Database::instance().initializeAchievements(playerId);
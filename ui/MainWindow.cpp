@@ -6,6 +6,7 @@
 #include "../src/achievement/AchievementManager.h"
 #include "../src/data/Database.h"
 #include "../src/data/RankManager.h"
+#include "../src/data/PersistenceWorker.h"
 #include <QDebug>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -17,6 +18,7 @@
 #include <QSettings>
 #include <QMessageBox>
 #include <QHeaderView>
+#include <QComboBox>
 
 /**
  * @brief 构造函数
@@ -62,6 +64,8 @@ MainWindow::MainWindow(QWidget *parent)
     , casualBuyHammerButton_(nullptr)
     , casualBuyClampButton_(nullptr)
     , casualBuyMagicWandButton_(nullptr)
+    , casualUndoButton_(nullptr)
+    , casualRedoButton_(nullptr)
     , compHammerButton_(nullptr)
     , compClampButton_(nullptr)
     , compMagicWandButton_(nullptr)
@@ -80,6 +84,7 @@ MainWindow::MainWindow(QWidget *parent)
         qCritical() << "Failed to initialize database!";
     } else {
         qDebug() << "Database initialized at:" << dbPath;
+        PersistenceWorker::instance().startWorker();
     }
     
     // 初始化成就系统（通用部分）
@@ -132,6 +137,9 @@ MainWindow::~MainWindow()
     // 关闭成就系统
     AchievementManager::instance().shutdown();
     
+    // 写完排队中的数据
+    PersistenceWorker::instance().shutdown();
+    
     // 关闭数据库连接
     Database::instance().close();
     qDebug() << "✅ Database closed";
@@ -275,6 +283,30 @@ void MainWindow::startCasualMode()
 {
     Q_ASSERT(gameEngine_ != nullptr);
     
+    if (currentPlayerId_ == "guest") {
+        launchCasualMode();
+        return;
+    }
+    
+    // 上一局结束时的写入可能还在排队：落盘后再读取存档，不阻塞界面线程
+    if (casualModePending_) {
+        return;
+    }
+    casualModePending_ = true;
+    const QString playerId = currentPlayerId_;
+    PersistenceWorker::instance().whenFlushed().then(this, [this, playerId](bool) {
+        casualModePending_ = false;
+        if (playerId == currentPlayerId_) {
+            launchCasualMode();
+        }
+    });
+}
+
+/**
+ * @brief 读取玩家存档并进入休闲模式游戏界面
+ */
+void MainWindow::launchCasualMode()
+{
     currentGameMode_ = GameModeType::CASUAL;
     
     // 从数据库加载玩家数据
@@ -293,8 +325,15 @@ void MainWindow::startCasualMode()
     QSettings settings("FruitCrush", "GameSettings");
     int mapSize = settings.value("casual/mapSize", 8).toInt();
     
-    // 初始化游戏引擎（传入地图大小）
-    gameEngine_->initializeGame(savedScore, mapSize);
+    // 初始化游戏引擎：优先恢复上次的棋盘存档（地图大小与设置一致时），否则新开一局
+    bool resumed = false;
+    if (currentPlayerId_ != "guest") {
+        QByteArray savedBoard = Database::instance().loadCasualBoard(currentPlayerId_);
+        resumed = !savedBoard.isEmpty() && gameEngine_->restoreGame(savedBoard, mapSize, savedScore);
+    }
+    if (!resumed) {
+        gameEngine_->initializeGame(savedScore, mapSize);
+    }
     gameEngine_->getPropManager().setAllProps(hammerCount, clampCount, magicWandCount);
     gameEngine_->startGameSession("Casual");
     
@@ -633,6 +672,26 @@ void MainWindow::createLeaderboardWidget()
     );
     layout->addWidget(titleLabel);
     
+    // 统计窗口选择
+    leaderboardWindowCombo_ = new QComboBox();
+    leaderboardWindowCombo_->addItem("🏆 总榜", static_cast<int>(LeaderboardWindow::ALL_TIME));
+    leaderboardWindowCombo_->addItem("☀️ 今日", static_cast<int>(LeaderboardWindow::DAILY));
+    leaderboardWindowCombo_->addItem("📅 本周", static_cast<int>(LeaderboardWindow::WEEKLY));
+    leaderboardWindowCombo_->addItem("🏁 本赛季", static_cast<int>(LeaderboardWindow::SEASON));
+    leaderboardWindowCombo_->setFixedWidth(180);
+    leaderboardWindowCombo_->setStyleSheet(
+        "QComboBox { "
+        "   font-size: 15px; "
+        "   padding: 8px 16px; "
+        "   border: 2px solid #42A5F5; "
+        "   border-radius: 15px; "
+        "   background-color: white; "
+        "}"
+    );
+    connect(leaderboardWindowCombo_, &QComboBox::currentIndexChanged,
+            this, &MainWindow::refreshLeaderboardData);
+    layout->addWidget(leaderboardWindowCombo_, 0, Qt::AlignRight);
+    
     // 创建Tab控件
     leaderboardTabWidget_ = new QTabWidget();
     leaderboardTabWidget_->setStyleSheet(
@@ -743,8 +802,41 @@ void MainWindow::createLeaderboardWidget()
  */
 void MainWindow::refreshLeaderboardData()
 {
-    auto fillTable = [this](QTableWidget* table, CompetitionDuration duration) {
-        auto records = RankManager::instance().getLeaderboard(duration, 20);
+    // 刚结束的比赛成绩落盘后再读取，不阻塞界面线程
+    PersistenceWorker::instance().whenFlushed().then(this, [this](bool) {
+        renderLeaderboardData();
+    });
+}
+
+/**
+ * @brief 读取并绘制排行榜数据
+ */
+void MainWindow::renderLeaderboardData()
+{
+    const LeaderboardWindow window = leaderboardWindowCombo_
+        ? static_cast<LeaderboardWindow>(leaderboardWindowCombo_->currentData().toInt())
+        : LeaderboardWindow::ALL_TIME;
+    
+    // 总榜走 RankManager 内存缓存：版本号、当前玩家、统计窗口都没变时不重绘
+    // 日/周/赛季榜每次从分桶表读取（索引区间查询）
+    const bool viewChanged = (leaderboardPlayerId_ != currentPlayerId_)
+                          || (leaderboardWindow_ != static_cast<int>(window));
+    leaderboardPlayerId_ = currentPlayerId_;
+    leaderboardWindow_ = static_cast<int>(window);
+    
+    auto fillTable = [this, window, viewChanged](QTableWidget* table, CompetitionDuration duration, quint64& renderedVersion) {
+        QList<RankRecord> records;
+        if (window == LeaderboardWindow::ALL_TIME) {
+            const quint64 version = RankManager::instance().getLeaderboardVersion(duration);
+            if (version != 0 && version == renderedVersion && !viewChanged) {
+                return;
+            }
+            records = RankManager::instance().getLeaderboard(duration, 20);
+            renderedVersion = RankManager::instance().getLeaderboardVersion(duration);
+        } else {
+            records = RankManager::instance().getLeaderboard(duration, window, 20);
+            renderedVersion = 0;
+        }
         table->setRowCount(records.size());
         
         for (int i = 0; i < records.size(); ++i) {
@@ -818,9 +910,9 @@ void MainWindow::refreshLeaderboardData()
         }
     };
     
-    fillTable(leaderboard60Table_, CompetitionDuration::SECONDS_60);
-    fillTable(leaderboard120Table_, CompetitionDuration::SECONDS_120);
-    fillTable(leaderboard180Table_, CompetitionDuration::SECONDS_180);
+    fillTable(leaderboard60Table_, CompetitionDuration::SECONDS_60, leaderboardVersions_[0]);
+    fillTable(leaderboard120Table_, CompetitionDuration::SECONDS_120, leaderboardVersions_[1]);
+    fillTable(leaderboard180Table_, CompetitionDuration::SECONDS_180, leaderboardVersions_[2]);
 }
 
 /**
@@ -1077,6 +1169,23 @@ void MainWindow::createCasualGameViewWidget()
     
     controlLayout->addSpacing(20);
     
+    // 撤销/重做按钮
+    casualUndoButton_ = new QPushButton("↶ 撤销");
+    casualUndoButton_->setMinimumSize(80, 40);
+    casualUndoButton_->setToolTip("撤销上一步操作");
+    casualUndoButton_->setEnabled(false);
+    connect(casualUndoButton_, &QPushButton::clicked, this, &MainWindow::onUndoClicked);
+    controlLayout->addWidget(casualUndoButton_);
+    
+    casualRedoButton_ = new QPushButton("↷ 重做");
+    casualRedoButton_->setMinimumSize(80, 40);
+    casualRedoButton_->setToolTip("重做被撤销的操作");
+    casualRedoButton_->setEnabled(false);
+    connect(casualRedoButton_, &QPushButton::clicked, this, &MainWindow::onRedoClicked);
+    controlLayout->addWidget(casualRedoButton_);
+    
+    controlLayout->addSpacing(20);
+    
     // 返回按钮
     QPushButton* backButton = new QPushButton("返回主菜单");
     backButton->setMinimumSize(120, 40);
@@ -1198,6 +1307,15 @@ void MainWindow::updateCasualPropCounts()
     if (casualBuyMagicWandButton_) {
         casualBuyMagicWandButton_->setEnabled(currentScore >= MAGIC_WAND_PRICE);
     }
+    
+    // 更新撤销/重做按钮状态（动画播放中禁用）
+    bool animating = casualGameView_ && casualGameView_->isAnimating();
+    if (casualUndoButton_) {
+        casualUndoButton_->setEnabled(!animating && gameEngine_->canUndo());
+    }
+    if (casualRedoButton_) {
+        casualRedoButton_->setEnabled(!animating && gameEngine_->canRedo());
+    }
 }
 
 /**
@@ -1316,6 +1434,32 @@ void MainWindow::onBuyMagicWand()
     updateCasualPropCounts();
 }
 
+/**
+ * @brief 撤销上一步
+ */
+void MainWindow::onUndoClicked()
+{
+    if (!gameEngine_ || !casualGameView_ || casualGameView_->isAnimating()) return;
+    
+    if (gameEngine_->undoMove()) {
+        casualGameView_->updateDisplay();
+        updateCasualPropCounts();
+    }
+}
+
+/**
+ * @brief 重做上一步
+ */
+void MainWindow::onRedoClicked()
+{
+    if (!gameEngine_ || !casualGameView_ || casualGameView_->isAnimating()) return;
+    
+    if (gameEngine_->redoMove()) {
+        casualGameView_->updateDisplay();
+        updateCasualPropCounts();
+    }
+}
+
 /**
  * @brief 创建比赛模式游戏视图（无购买按钮，有倒计时）
  */
@@ -1508,19 +1652,30 @@ void MainWindow::showCompetitionEndScreen(int finalScore, int maxCombo)
     bool isPersonalBest = RankManager::instance().isPersonalBest(
         currentPlayerId_, finalScore, currentCompetitionDuration_);
     
+    // 成绩与对局记录交给持久化线程写入（同一事务），写完后再刷新排名
+    QFuture<bool> saved;
     if (currentPlayerId_ != "guest") {
-        RankManager::instance().recordScore(
-            currentPlayerId_, 
-            currentPlayerName_,
-            finalScore, 
-            maxCombo, 
-            currentCompetitionDuration_
-        );
+        GameRecord record;
+        record.playerId = currentPlayerId_;
+        record.mode = "Competition";
+        record.score = finalScore;
+        record.maxCombo = maxCombo;
+        record.playedAt = QDateTime::currentDateTime();
+        
+        const QString playerId = currentPlayerId_;
+        const QString playerName = currentPlayerName_;
+        const CompetitionDuration duration = currentCompetitionDuration_;
+        saved = PersistenceWorker::instance().submit({
+            [playerId, playerName, finalScore, maxCombo, duration]() {
+                return RankManager::instance().recordScore(
+                    playerId, playerName, finalScore, maxCombo, duration);
+            },
+            [record]() {
+                return Database::instance().saveGameRecord(record);
+            }
+        });
     }
     
-    // 获取排名
-    int rank = RankManager::instance().getPlayerRank(currentPlayerId_, currentCompetitionDuration_);
-    
     // 创建结束界面
     if (!competitionEndWidget_) {
         createCompetitionEndWidget();
@@ -1539,10 +1694,6 @@ void MainWindow::showCompetitionEndScreen(int finalScore, int maxCombo)
         if (isPersonalBest) {
             message = "🎉 恭喜！新的个人最佳记录！";
         }
-        if (rank > 0 && rank <= 10) {
-            if (!message.isEmpty()) message += "\n";
-            message += QString("🏅 当前排名: 第 %1 名").arg(rank);
-        }
     } else {
         message = "💡 登录后可保存成绩到排行榜";
     }
@@ -1555,6 +1706,25 @@ void MainWindow::showCompetitionEndScreen(int finalScore, int maxCombo)
         endMessageLabel_->setText(message);
     }
     
+    // 成绩落盘后补充排名信息
+    if (currentPlayerId_ != "guest") {
+        const QString playerId = currentPlayerId_;
+        const CompetitionDuration duration = currentCompetitionDuration_;
+        saved.then(this, [this, playerId, duration, message](bool ok) {
+            if (!ok) {
+                qWarning() << "Failed to save competition result";
+                return;
+            }
+            int rank = RankManager::instance().getPlayerRank(playerId, duration);
+            if (rank > 0 && rank <= 10 && endMessageLabel_) {
+                QString text = message;
+                if (!text.isEmpty()) text += "\n";
+                text += QString("🏅 当前排名: 第 %1 名").arg(rank);
+                endMessageLabel_->setText(text);
+            }
+        });
+    }
+    
     // 显示结束界面
     if (!ui->stackedWidget->findChild<QWidget*>("competitionEndWidget")) {
         ui->stackedWidget->addWidget(competitionEndWidget_);
@@ -16,6 +16,7 @@
 
 QT_BEGIN_NAMESPACE
 namespace Ui { class MainWindow; }
+class QComboBox;
 QT_END_NAMESPACE
 
 /**
@@ -118,6 +119,16 @@ private slots:
      */
     void onBuyMagicWand();
     
+    /**
+     * @brief 撤销上一步（休闲模式）
+     */
+    void onUndoClicked();
+    
+    /**
+     * @brief 重做上一步（休闲模式）
+     */
+    void onRedoClicked();
+    
     /**
      * @brief 比赛倒计时更新
      */
@@ -173,6 +184,11 @@ private:
     QTableWidget* leaderboard60Table_;
     QTableWidget* leaderboard120Table_;
     QTableWidget* leaderboard180Table_;
+    QComboBox* leaderboardWindowCombo_ = nullptr;   // 统计窗口选择（总榜/今日/本周/本赛季）
+    quint64 leaderboardVersions_[3] = {0, 0, 0};  // 已绘制的排行榜缓存版本（60/120/180秒）
+    QString leaderboardPlayerId_;                   // 绘制时的当前玩家（高亮用）
+    int leaderboardWindow_ = 0;                     // 绘制时的统计窗口（LeaderboardWindow）
+    bool casualModePending_ = false;                // 正在等待写入落盘后进入休闲模式
     
     // 休闲模式游戏视图
     GameView* casualGameView_;
@@ -195,6 +211,8 @@ private:
     QPushButton* casualBuyHammerButton_;
     QPushButton* casualBuyClampButton_;
     QPushButton* casualBuyMagicWandButton_;
+    QPushButton* casualUndoButton_;
+    QPushButton* casualRedoButton_;
     
     // 比赛模式道具按钮
     QPushButton* compHammerButton_;
@@ -243,10 +261,20 @@ private:
     void createLeaderboardWidget();
     
     /**
-     * @brief 刷新排行榜数据
+     * @brief 刷新排行榜数据（待写入的成绩落盘后再读取）
      */
     void refreshLeaderboardData();
     
+    /**
+     * @brief 读取并绘制排行榜数据
+     */
+    void renderLeaderboardData();
+    
+    /**
+     * @brief 读取玩家存档并进入休闲模式游戏界面
+     */
+    void launchCasualMode();
+    
     /**
      * @brief 创建休闲模式游戏视图
      */
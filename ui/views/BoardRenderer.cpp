@@ -0,0 +1,780 @@
+#include "BoardRenderer.h"
+#include "TextureExtractor.h"
+#include <QOpenGLTexture>
+#include <QOpenGLFramebufferObject>
+#include <QImage>
+#include <QDebug>
+#include <cmath>
+#include <utility>
+
+namespace {
+
+// 实例化精灵：顶点位置由格子索引 + 动画偏移在着色器中计算
+const char* const SPRITE_VERTEX_SHADER = R"(
+    #version 330 core
+    layout(location = 0) in vec2 a_corner;      // 单位四边形顶点 (0..1)
+    layout(location = 1) in vec4 a_cell;        // 格子索引, 精灵索引, 特殊类型, 缩放
+    layout(location = 2) in vec3 a_offset;      // 偏移 X, 偏移 Y, 透明度
+
+    uniform mat4 u_projection;
+    uniform vec2 u_gridOrigin;
+    uniform float u_cellSize;
+    uniform int u_mapSize;
+
+    out vec2 v_uv;
+    out float v_alpha;
+    flat out int v_sprite;
+    flat out int v_special;
+    flat out float v_size;
+
+    void main()
+    {
+        int cell = int(a_cell.x + 0.5);
+        vec2 gridPos = vec2(cell % u_mapSize, cell / u_mapSize);
+        float size = u_cellSize * a_cell.w;
+        vec2 topLeft = u_gridOrigin + gridPos * u_cellSize + a_offset.xy
+                     + vec2((u_cellSize - size) * 0.5);
+
+        gl_Position = u_projection * vec4(topLeft + a_corner * size, 0.0, 1.0);
+        v_uv = a_corner;
+        v_alpha = a_offset.z;
+        v_sprite = int(floor(a_cell.y + 0.5));
+        v_special = int(a_cell.z + 0.5);
+        v_size = size;
+    }
+)";
+
+// 背景：纯色；水果：留 10% 边距从图集采样；特殊元素：叠加内描边
+// 低细节模式：水果取调色板中的平均色画成方块，特殊元素改为中心圆点
+const char* const SPRITE_FRAGMENT_SHADER = R"(
+    #version 330 core
+    in vec2 v_uv;
+    in float v_alpha;
+    flat in int v_sprite;
+    flat in int v_special;
+    flat in float v_size;
+
+    uniform sampler2D u_atlas;
+    uniform sampler2D u_palette;                // 每个精灵的平均色 (SPRITE_COUNT x 1)
+    uniform bool u_lowDetail;
+    uniform vec4 u_atlasRects[16];              // 每个精灵的 UV (u0, v0, u1, v1)
+    uniform vec4 u_backgroundColor;
+    uniform vec4 u_specialColors[5];
+    uniform float u_borderWidth;
+
+    out vec4 fragColor;
+
+    void main()
+    {
+        if (v_sprite < 0) {
+            fragColor = u_backgroundColor;
+            return;
+        }
+
+        vec4 color = vec4(0.0);
+        if (u_lowDetail) {
+            vec2 d = abs(v_uv - vec2(0.5));
+            if (max(d.x, d.y) <= 0.4) {
+                color = texelFetch(u_palette, ivec2(v_sprite, 0), 0);
+            }
+            if (v_special > 0 && length(v_uv - vec2(0.5)) < 0.22) {
+                color = vec4(u_specialColors[v_special].rgb, 1.0);
+            }
+        } else {
+            vec2 fruitUv = (v_uv - vec2(0.1)) / 0.8;
+            if (all(greaterThanEqual(fruitUv, vec2(0.0))) && all(lessThanEqual(fruitUv, vec2(1.0)))) {
+                vec4 rect = u_atlasRects[v_sprite];
+                color = texture(u_atlas, mix(rect.xy, rect.zw, fruitUv));
+            }
+        }
+
+        if (v_special > 0 && !u_lowDetail) {
+            vec2 px = v_uv * v_size;
+            float edge = min(min(px.x, px.y), min(v_size - px.x, v_size - px.y));
+            if (edge < u_borderWidth) {
+                vec4 border = u_specialColors[v_special];
+                color = vec4(mix(color.rgb, border.rgb, border.a), border.a + color.a * (1.0 - border.a));
+            }
+        }
+
+        color.a *= v_alpha;
+        if (color.a <= 0.0) {
+            discard;
+        }
+        fragColor = color;
+    }
+)";
+
+// 运动精灵：起点/终点/延迟/缓动为每实例数据，位置由阶段进度在着色器中插值
+const char* const MOTION_VERTEX_SHADER = R"(
+    #version 330 core
+    layout(location = 0) in vec2 a_corner;      // 单位四边形顶点 (0..1)
+    layout(location = 1) in vec4 a_path;        // 起点列, 起点行, 终点列, 终点行
+    layout(location = 2) in vec4 a_sprite;      // 精灵索引, 特殊类型, 起始延迟, 缓动
+
+    uniform mat4 u_projection;
+    uniform vec2 u_gridOrigin;
+    uniform float u_cellSize;
+    uniform float u_progress;
+
+    out vec2 v_uv;
+    out float v_alpha;
+    flat out int v_sprite;
+    flat out int v_special;
+    flat out float v_size;
+
+    const int EASE_PING_PONG = 1;
+
+    void main()
+    {
+        float delay = a_sprite.z;
+        float t = clamp((u_progress - delay) / max(1.0 - delay, 0.0001), 0.0, 1.0);
+        if (int(a_sprite.w + 0.5) == EASE_PING_PONG) {
+            t = 1.0 - abs(1.0 - 2.0 * t);
+        }
+
+        vec2 gridPos = mix(a_path.xy, a_path.zw, t);
+        vec2 topLeft = u_gridOrigin + gridPos * u_cellSize;
+
+        gl_Position = u_projection * vec4(topLeft + a_corner * u_cellSize, 0.0, 1.0);
+        v_uv = a_corner;
+        v_alpha = 1.0;
+        v_sprite = int(floor(a_sprite.x + 0.5));
+        v_special = int(a_sprite.y + 0.5);
+        v_size = u_cellSize;
+    }
+)";
+
+const char* const COLOR_VERTEX_SHADER = R"(
+    #version 330 core
+    layout(location = 0) in vec2 a_position;
+    layout(location = 1) in vec4 a_color;
+    uniform mat4 u_projection;
+    out vec4 v_color;
+
+    void main()
+    {
+        gl_Position = u_projection * vec4(a_position, 0.0, 1.0);
+        v_color = a_color;
+    }
+)";
+
+const char* const COLOR_FRAGMENT_SHADER = R"(
+    #version 330 core
+    in vec4 v_color;
+    out vec4 fragColor;
+
+    void main()
+    {
+        fragColor = v_color;
+    }
+)";
+
+const float SPECIAL_BORDER_WIDTH = 3.0f;    // 特殊元素描边宽度（像素）
+
+// 预先打包好的图集（TextureExtractorTool --atlas 生成）
+const char* const ATLAS_IMAGE_PATH = "resources/textures/fruit_atlas.png";
+const char* const ATLAS_META_PATH = "resources/textures/fruit_atlas.json";
+
+/**
+ * @brief 图集精灵来源（顺序与 BoardRenderer::AtlasSprite 一致）
+ */
+struct AtlasSource {
+    const char* name;
+    const char* file;
+};
+
+const AtlasSource ATLAS_SOURCES[BoardRenderer::SPRITE_COUNT] = {
+    { "apple", "resources/textures/apple.png" },
+    { "orange", "resources/textures/orange.png" },
+    { "grape", "resources/textures/grape.png" },
+    { "banana", "resources/textures/banana.png" },
+    { "watermelon", "resources/textures/watermelon.png" },
+    { "strawberry", "resources/textures/strawberry.png" },
+    { "candy", "resources/textures/Candy.png" },
+    { "hammer", "resources/props/hammer.png" },
+    { "clamp", "resources/props/clamp.png" },
+    { "magic_wand", "resources/props/magic_wand.png" }
+};
+
+} // namespace
+
+BoardRenderer::BoardRenderer()
+    : quadBuffer_(QOpenGLBuffer::VertexBuffer)
+    , instanceBuffer_(QOpenGLBuffer::VertexBuffer)
+    , colorBuffer_(QOpenGLBuffer::VertexBuffer)
+    , motionBuffer_(QOpenGLBuffer::VertexBuffer)
+{
+}
+
+BoardRenderer::~BoardRenderer()
+{
+    // GPU 资源须由持有者在上下文有效时调用 cleanup() 释放
+}
+
+/**
+ * @brief 初始化 GPU 资源
+ */
+bool BoardRenderer::initialize()
+{
+    initializeOpenGLFunctions();
+
+    // 1. 着色器
+    if (!buildPrograms()) {
+        return false;
+    }
+
+    // 2. 精灵 VAO：单位四边形 + 每实例属性
+    const float corners[] = {
+        0.0f, 0.0f,
+        1.0f, 0.0f,
+        0.0f, 1.0f,
+        1.0f, 1.0f
+    };
+
+    spriteVao_.create();
+    spriteVao_.bind();
+
+    quadBuffer_.create();
+    quadBuffer_.bind();
+    quadBuffer_.allocate(corners, sizeof(corners));
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), nullptr);
+
+    instanceBuffer_.create();
+    instanceBuffer_.setUsagePattern(QOpenGLBuffer::StreamDraw);
+    instanceBuffer_.bind();
+    glEnableVertexAttribArray(1);
+    glEnableVertexAttribArray(2);
+    glVertexAttribDivisor(1, 1);
+    glVertexAttribDivisor(2, 1);
+
+    spriteVao_.release();
+
+    // 3. 纯色矩形 VAO
+    colorVao_.create();
+    colorVao_.bind();
+
+    colorBuffer_.create();
+    colorBuffer_.setUsagePattern(QOpenGLBuffer::StreamDraw);
+    colorBuffer_.bind();
+    glEnableVertexAttribArray(0);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(ColorVertex), nullptr);
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(ColorVertex),
+                          reinterpret_cast<const void*>(2 * sizeof(float)));
+
+    colorVao_.release();
+    colorBuffer_.release();
+
+    // 4. 运动精灵 VAO：共用单位四边形 + 每实例路径
+    motionVao_.create();
+    motionVao_.bind();
+
+    quadBuffer_.bind();
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), nullptr);
+
+    motionBuffer_.create();
+    motionBuffer_.setUsagePattern(QOpenGLBuffer::StaticDraw);
+    motionBuffer_.bind();
+    glEnableVertexAttribArray(1);
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(MotionInstance), nullptr);
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(MotionInstance),
+                          reinterpret_cast<const void*>(4 * sizeof(float)));
+    glVertexAttribDivisor(1, 1);
+    glVertexAttribDivisor(2, 1);
+
+    motionVao_.release();
+    motionBuffer_.release();
+
+    // 5. 图集纹理
+    if (!loadAtlas()) {
+        return false;
+    }
+
+    initialized_ = true;
+    qDebug() << "BoardRenderer initialized";
+    return true;
+}
+
+bool BoardRenderer::buildPrograms()
+{
+    if (!spriteProgram_.addShaderFromSourceCode(QOpenGLShader::Vertex, SPRITE_VERTEX_SHADER)
+        || !spriteProgram_.addShaderFromSourceCode(QOpenGLShader::Fragment, SPRITE_FRAGMENT_SHADER)
+        || !spriteProgram_.link()) {
+        qCritical() << "Failed to build sprite shader:" << spriteProgram_.log();
+        return false;
+    }
+
+    if (!colorProgram_.addShaderFromSourceCode(QOpenGLShader::Vertex, COLOR_VERTEX_SHADER)
+        || !colorProgram_.addShaderFromSourceCode(QOpenGLShader::Fragment, COLOR_FRAGMENT_SHADER)
+        || !colorProgram_.link()) {
+        qCritical() << "Failed to build color shader:" << colorProgram_.log();
+        return false;
+    }
+
+    if (!motionProgram_.addShaderFromSourceCode(QOpenGLShader::Vertex, MOTION_VERTEX_SHADER)
+        || !motionProgram_.addShaderFromSourceCode(QOpenGLShader::Fragment, SPRITE_FRAGMENT_SHADER)
+        || !motionProgram_.link()) {
+        qCritical() << "Failed to build motion shader:" << motionProgram_.log();
+        return false;
+    }
+
+    // 不随帧变化的 uniform（精灵与运动程序共用片段着色器）
+    const QVector4D specialColors[5] = {
+        QVector4D(0.0f, 0.0f, 0.0f, 0.0f),      // NONE
+        QVector4D(1.0f, 0.70f, 0.28f, 0.8f),    // LINE_H  #FFB347 金黄色
+        QVector4D(1.0f, 0.70f, 0.28f, 0.8f),    // LINE_V  #FFB347 金黄色
+        QVector4D(0.53f, 0.81f, 1.0f, 0.8f),    // DIAMOND #87CEFA 浅蓝色
+        QVector4D(1.0f, 0.71f, 0.76f, 0.8f)     // RAINBOW #FFB5C2 浅粉色
+    };
+    for (QOpenGLShaderProgram* program : { &spriteProgram_, &motionProgram_ }) {
+        program->bind();
+        program->setUniformValue("u_atlas", 0);
+        program->setUniformValue("u_palette", 1);
+        program->setUniformValue("u_backgroundColor", QVector4D(1.0f, 0.96f, 0.93f, 1.0f));  // #FFF5ED 浅奶油色
+        program->setUniformValue("u_borderWidth", SPECIAL_BORDER_WIDTH);
+        program->setUniformValueArray("u_specialColors", specialColors, 5);
+        program->release();
+    }
+    return true;
+}
+
+/**
+ * @brief 加载水果/道具图集（优先使用预打包文件，缺失时在内存中打包）
+ */
+bool BoardRenderer::loadAtlas()
+{
+    TextureExtractor extractor;
+    
+    // 1. 预打包的图集需包含全部精灵
+    bool loaded = extractor.loadAtlas(ATLAS_IMAGE_PATH, ATLAS_META_PATH);
+    for (int i = 0; loaded && i < SPRITE_COUNT; ++i) {
+        loaded = extractor.findSprite(ATLAS_SOURCES[i].name) != nullptr;
+    }
+    
+    // 2. 否则从单张图片现场打包
+    if (!loaded) {
+        QStringList names;
+        std::vector<QImage> images;
+        for (const auto& source : ATLAS_SOURCES) {
+            QImage image(source.file);
+            if (image.isNull()) {
+                qWarning() << "Failed to load texture:" << source.file;
+            }
+            names.append(source.name);
+            images.push_back(image);
+        }
+        if (!extractor.packAtlas(names, images)) {
+            qCritical() << "Failed to pack texture atlas";
+            return false;
+        }
+    }
+    
+    // 3. 上传纹理与 UV 表
+    atlasTexture_ = new QOpenGLTexture(QOpenGLTexture::Target2D);
+    atlasTexture_->setData(extractor.getAtlasImage().convertToFormat(QImage::Format_RGBA8888));
+    atlasTexture_->setMinificationFilter(QOpenGLTexture::Linear);
+    atlasTexture_->setMagnificationFilter(QOpenGLTexture::Linear);
+    atlasTexture_->setWrapMode(QOpenGLTexture::ClampToEdge);
+    
+    QVector4D rects[SPRITE_COUNT];
+    for (int i = 0; i < SPRITE_COUNT; ++i) {
+        const auto* sprite = extractor.findSprite(ATLAS_SOURCES[i].name);
+        rects[i] = QVector4D(sprite->uv.left(), sprite->uv.top(), sprite->uv.right(), sprite->uv.bottom());
+    }
+    for (QOpenGLShaderProgram* program : { &spriteProgram_, &motionProgram_ }) {
+        program->bind();
+        program->setUniformValueArray("u_atlasRects", rects, SPRITE_COUNT);
+        program->release();
+    }
+    
+    // 4. 低细节模式调色板：每个精灵不透明像素的平均色
+    const QImage atlasImage = extractor.getAtlasImage().convertToFormat(QImage::Format_ARGB32);
+    QImage palette(SPRITE_COUNT, 1, QImage::Format_RGBA8888);
+    for (int i = 0; i < SPRITE_COUNT; ++i) {
+        const QRect area = extractor.findSprite(ATLAS_SOURCES[i].name)->rect & atlasImage.rect();
+        double sumR = 0.0, sumG = 0.0, sumB = 0.0, sumA = 0.0;
+        for (int y = area.top(); y <= area.bottom(); ++y) {
+            for (int x = area.left(); x <= area.right(); ++x) {
+                const QRgb pixel = atlasImage.pixel(x, y);
+                const double a = qAlpha(pixel) / 255.0;
+                sumR += qRed(pixel) * a;
+                sumG += qGreen(pixel) * a;
+                sumB += qBlue(pixel) * a;
+                sumA += a;
+            }
+        }
+        palette.setPixel(i, 0, sumA > 0.0
+            ? qRgba(static_cast<int>(sumR / sumA), static_cast<int>(sumG / sumA),
+                    static_cast<int>(sumB / sumA), 255)
+            : qRgba(200, 200, 200, 255));
+    }
+    paletteTexture_ = new QOpenGLTexture(QOpenGLTexture::Target2D);
+    paletteTexture_->setData(palette);
+    paletteTexture_->setMinificationFilter(QOpenGLTexture::Nearest);
+    paletteTexture_->setMagnificationFilter(QOpenGLTexture::Nearest);
+    paletteTexture_->setWrapMode(QOpenGLTexture::ClampToEdge);
+    
+    qDebug() << "Texture atlas ready:" << extractor.getAtlasImage().width() << "x"
+             << extractor.getAtlasImage().height() << (loaded ? "(prebuilt)" : "(packed at startup)");
+    return true;
+}
+
+void BoardRenderer::cleanup()
+{
+    delete atlasTexture_;
+    atlasTexture_ = nullptr;
+    delete paletteTexture_;
+    paletteTexture_ = nullptr;
+    delete staticLayer_;
+    staticLayer_ = nullptr;
+    staticLayerValid_ = false;
+    staticLayerUnsupported_ = false;
+
+    if (initialized_) {
+        spriteVao_.destroy();
+        colorVao_.destroy();
+        motionVao_.destroy();
+        quadBuffer_.destroy();
+        instanceBuffer_.destroy();
+        colorBuffer_.destroy();
+        motionBuffer_.destroy();
+        spriteProgram_.removeAllShaders();
+        colorProgram_.removeAllShaders();
+        motionProgram_.removeAllShaders();
+        motionsDirty_ = !motions_.empty();
+        initialized_ = false;
+    }
+}
+
+void BoardRenderer::beginFrame(int viewportWidth, int viewportHeight,
+                               float gridStartX, float gridStartY, float cellSize, int mapSize)
+{
+    projection_.setToIdentity();
+    projection_.ortho(0.0f, viewportWidth, viewportHeight, 0.0f, -1.0f, 1.0f);
+
+    gridStartX_ = gridStartX;
+    gridStartY_ = gridStartY;
+    cellSize_ = cellSize;
+    mapSize_ = mapSize;
+    viewportWidth_ = viewportWidth;
+    viewportHeight_ = viewportHeight;
+    drawCalls_ = 0;
+
+    // 视口内可见的行列（缩放平移后大地图只提交这部分格子）
+    auto clampIndex = [mapSize](float value) {
+        return qBound(0, static_cast<int>(value), mapSize);
+    };
+    visibleCells_.colBegin = clampIndex(std::floor(-gridStartX / cellSize));
+    visibleCells_.colEnd = clampIndex(std::ceil((viewportWidth - gridStartX) / cellSize));
+    visibleCells_.rowBegin = clampIndex(std::floor(-gridStartY / cellSize));
+    visibleCells_.rowEnd = clampIndex(std::ceil((viewportHeight - gridStartY) / cellSize));
+
+    for (auto& bucket : spriteBuckets_) {
+        bucket.clear();
+    }
+    rectVertices_.clear();
+}
+
+void BoardRenderer::addCellBackgrounds()
+{
+    flushRects();
+
+    auto& bucket = spriteBuckets_[0];
+    const CellRange& range = visibleCells_;
+    bucket.reserve(bucket.size() + (range.rowEnd - range.rowBegin) * (range.colEnd - range.colBegin));
+    for (int row = range.rowBegin; row < range.rowEnd; ++row) {
+        for (int col = range.colBegin; col < range.colEnd; ++col) {
+            bucket.push_back({ static_cast<float>(row * mapSize_ + col), -1.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f });
+        }
+    }
+}
+
+void BoardRenderer::addFruit(int row, int col, const Fruit& fruit,
+                             float offsetX, float offsetY, float alpha, float scale)
+{
+    const int spriteIndex = spriteIndexFor(fruit.type);
+    if (spriteIndex < 0) {
+        return;
+    }
+
+    // 视口剔除（按缩放后的尺寸估算屏幕矩形）
+    const float size = cellSize_ * qMax(scale, 1.0f);
+    const float x = gridStartX_ + col * cellSize_ + offsetX - (size - cellSize_) * 0.5f;
+    const float y = gridStartY_ + row * cellSize_ + offsetY - (size - cellSize_) * 0.5f;
+    if (x + size < 0.0f || y + size < 0.0f || x > viewportWidth_ || y > viewportHeight_) {
+        return;
+    }
+
+    flushRects();
+
+    spriteBuckets_[1].push_back({
+        static_cast<float>(row * mapSize_ + col),
+        static_cast<float>(spriteIndex),
+        static_cast<float>(fruit.special),
+        scale, offsetX, offsetY, alpha
+    });
+}
+
+void BoardRenderer::addRect(float x, float y, float width, float height, const QVector4D& color)
+{
+    flushSprites();
+
+    const float r = color.x(), g = color.y(), b = color.z(), a = color.w();
+    const ColorVertex quad[6] = {
+        { x, y, r, g, b, a },
+        { x + width, y, r, g, b, a },
+        { x, y + height, r, g, b, a },
+        { x + width, y, r, g, b, a },
+        { x + width, y + height, r, g, b, a },
+        { x, y + height, r, g, b, a }
+    };
+    rectVertices_.insert(rectVertices_.end(), quad, quad + 6);
+}
+
+void BoardRenderer::addRectOutline(float x, float y, float width, float height,
+                                   float lineWidth, const QVector4D& color)
+{
+    addRect(x, y, width, lineWidth, color);                                     // 上
+    addRect(x, y + height - lineWidth, width, lineWidth, color);                // 下
+    addRect(x, y + lineWidth, lineWidth, height - lineWidth * 2, color);        // 左
+    addRect(x + width - lineWidth, y + lineWidth, lineWidth, height - lineWidth * 2, color);  // 右
+}
+
+void BoardRenderer::flush()
+{
+    flushSprites();
+    flushRects();
+}
+
+bool BoardRenderer::makeMotion(const Fruit& fruit, float fromRow, float fromCol, int toRow, int toCol,
+                               MotionEasing easing, float delay, MotionInstance& motion)
+{
+    const int spriteIndex = spriteIndexFor(fruit.type);
+    if (spriteIndex < 0) {
+        return false;
+    }
+
+    motion = {
+        fromCol, fromRow,
+        static_cast<float>(toCol), static_cast<float>(toRow),
+        static_cast<float>(spriteIndex),
+        static_cast<float>(fruit.special),
+        delay,
+        static_cast<float>(easing)
+    };
+    return true;
+}
+
+void BoardRenderer::setMotions(std::vector<MotionInstance> motions)
+{
+    motions_ = std::move(motions);
+    motionsDirty_ = true;
+}
+
+void BoardRenderer::uploadMotions()
+{
+    motionBuffer_.bind();
+    motionBuffer_.allocate(motions_.data(),
+                           static_cast<int>(motions_.size() * sizeof(MotionInstance)));
+    motionBuffer_.release();
+    motionsDirty_ = false;
+}
+
+/**
+ * @brief 按阶段进度绘制全部运动
+ */
+void BoardRenderer::drawMotions(float progress)
+{
+    if (motions_.empty() || !atlasTexture_) {
+        return;
+    }
+
+    // 保持提交顺序：先画之前排队的内容
+    flush();
+
+    // 1. 运动列表只在阶段开始后的第一帧上传
+    if (motionsDirty_) {
+        uploadMotions();
+    }
+
+    // 2. 每帧只更新进度 uniform
+    motionProgram_.bind();
+    motionProgram_.setUniformValue("u_projection", projection_);
+    motionProgram_.setUniformValue("u_gridOrigin", gridStartX_, gridStartY_);
+    motionProgram_.setUniformValue("u_cellSize", cellSize_);
+    motionProgram_.setUniformValue("u_progress", progress);
+    motionProgram_.setUniformValue("u_lowDetail", (isLowDetail() && paletteTexture_) ? 1 : 0);
+    atlasTexture_->bind(0);
+    if (paletteTexture_) {
+        paletteTexture_->bind(1);
+    }
+
+    motionVao_.bind();
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(motions_.size()));
+    ++drawCalls_;
+    motionVao_.release();
+    motionProgram_.release();
+}
+
+bool BoardRenderer::needsStaticLayerUpdate(int pixelWidth, int pixelHeight) const
+{
+    if (staticLayerUnsupported_ && pixelWidth == unsupportedWidth_ && pixelHeight == unsupportedHeight_) {
+        return false;  // 同一尺寸下不再每帧重试，直接绘制到屏幕
+    }
+    return !staticLayerValid_ || !staticLayer_
+        || staticLayer_->width() != pixelWidth || staticLayer_->height() != pixelHeight;
+}
+
+/**
+ * @brief 开始录制静态层
+ */
+bool BoardRenderer::beginStaticLayer(int pixelWidth, int pixelHeight)
+{
+    flush();
+    staticLayerValid_ = false;
+
+    // 1. 尺寸变化时重建 FBO（无需深度缓冲）
+    if (!staticLayer_ || staticLayer_->width() != pixelWidth || staticLayer_->height() != pixelHeight) {
+        delete staticLayer_;
+        staticLayer_ = new QOpenGLFramebufferObject(QSize(pixelWidth, pixelHeight),
+                                                    QOpenGLFramebufferObject::NoAttachment,
+                                                    GL_TEXTURE_2D, GL_RGBA8);
+        if (!staticLayer_->isValid()) {
+            qWarning() << "Failed to create static layer FBO, drawing board directly";
+            delete staticLayer_;
+            staticLayer_ = nullptr;
+            staticLayerUnsupported_ = true;
+            unsupportedWidth_ = pixelWidth;
+            unsupportedHeight_ = pixelHeight;
+            return false;
+        }
+    }
+    staticLayerUnsupported_ = false;
+
+    // 2. 记下 QOpenGLWidget 自己的帧缓冲与视口，录制结束后恢复
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &savedFramebuffer_);
+    glGetIntegerv(GL_VIEWPORT, savedViewport_);
+
+    staticLayer_->bind();
+    glViewport(0, 0, pixelWidth, pixelHeight);
+    glClear(GL_COLOR_BUFFER_BIT);
+    return true;
+}
+
+void BoardRenderer::endStaticLayer()
+{
+    flush();
+    glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(savedFramebuffer_));
+    glViewport(savedViewport_[0], savedViewport_[1], savedViewport_[2], savedViewport_[3]);
+    staticLayerValid_ = true;
+}
+
+/**
+ * @brief 把静态层复制到当前帧缓冲
+ */
+bool BoardRenderer::compositeStaticLayer()
+{
+    if (!staticLayerValid_ || !staticLayer_) {
+        return false;
+    }
+
+    flush();
+
+    GLint drawFramebuffer = 0;
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &drawFramebuffer);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, staticLayer_->handle());
+    glBlitFramebuffer(0, 0, staticLayer_->width(), staticLayer_->height(),
+                      0, 0, staticLayer_->width(), staticLayer_->height(),
+                      GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(drawFramebuffer));
+    ++drawCalls_;
+    return true;
+}
+
+/**
+ * @brief 合并上传背景与精灵实例，一次实例化绘制
+ */
+void BoardRenderer::flushSprites()
+{
+    // 1. 背景在前、精灵在后，合并到一块连续内存
+    uploadScratch_.clear();
+    for (const auto& bucket : spriteBuckets_) {
+        uploadScratch_.insert(uploadScratch_.end(), bucket.begin(), bucket.end());
+    }
+    if (uploadScratch_.empty() || !atlasTexture_) {
+        return;
+    }
+
+    spriteProgram_.bind();
+    spriteProgram_.setUniformValue("u_projection", projection_);
+    spriteProgram_.setUniformValue("u_gridOrigin", gridStartX_, gridStartY_);
+    spriteProgram_.setUniformValue("u_cellSize", cellSize_);
+    spriteProgram_.setUniformValue("u_mapSize", mapSize_);
+    spriteProgram_.setUniformValue("u_lowDetail", (isLowDetail() && paletteTexture_) ? 1 : 0);
+    atlasTexture_->bind(0);
+    if (paletteTexture_) {
+        paletteTexture_->bind(1);
+    }
+
+    // 2. 一次上传、一次绘制
+    spriteVao_.bind();
+    instanceBuffer_.bind();
+    instanceBuffer_.allocate(uploadScratch_.data(),
+                             static_cast<int>(uploadScratch_.size() * sizeof(SpriteInstance)));
+
+    const GLsizei stride = sizeof(SpriteInstance);
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, stride, nullptr);
+    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, stride,
+                          reinterpret_cast<const void*>(4 * sizeof(float)));
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(uploadScratch_.size()));
+    ++drawCalls_;
+
+    instanceBuffer_.release();
+    spriteVao_.release();
+    spriteProgram_.release();
+
+    for (auto& bucket : spriteBuckets_) {
+        bucket.clear();
+    }
+}
+
+void BoardRenderer::flushRects()
+{
+    if (rectVertices_.empty()) {
+        return;
+    }
+
+    colorProgram_.bind();
+    colorProgram_.setUniformValue("u_projection", projection_);
+
+    colorVao_.bind();
+    colorBuffer_.bind();
+    colorBuffer_.allocate(rectVertices_.data(),
+                          static_cast<int>(rectVertices_.size() * sizeof(ColorVertex)));
+    glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(rectVertices_.size()));
+    ++drawCalls_;
+
+    colorBuffer_.release();
+    colorVao_.release();
+    colorProgram_.release();
+
+    rectVertices_.clear();
+}
+
+int BoardRenderer::spriteIndexFor(FruitType type)
+{
+    switch (type) {
+        case FruitType::APPLE:      return SPRITE_APPLE;
+        case FruitType::ORANGE:     return SPRITE_ORANGE;
+        case FruitType::GRAPE:      return SPRITE_GRAPE;
+        case FruitType::BANANA:     return SPRITE_BANANA;
+        case FruitType::WATERMELON: return SPRITE_WATERMELON;
+        case FruitType::STRAWBERRY: return SPRITE_STRAWBERRY;
+        case FruitType::CANDY:      return SPRITE_CANDY;
+        default:                    return -1;
+    }
+}
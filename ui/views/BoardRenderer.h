@@ -0,0 +1,268 @@
+#ifndef BOARDRENDERER_H
+#define BOARDRENDERER_H
+
+#include <QOpenGLExtraFunctions>
+#include <QOpenGLShaderProgram>
+#include <QOpenGLBuffer>
+#include <QOpenGLVertexArrayObject>
+#include <QMatrix4x4>
+#include <QVector4D>
+#include <vector>
+#include <array>
+#include "FruitTypes.h"
+
+class QOpenGLTexture;
+class QOpenGLFramebufferObject;
+
+/**
+ * @brief 棋盘精灵实例（实例缓冲中的一项，按格子索引定位）
+ */
+struct SpriteInstance {
+    float cell;         ///< 格子索引 row * mapSize + col
+    float type;         ///< 图集精灵索引（-1 表示格子背景）
+    float special;      ///< SpecialType（0 为普通）
+    float scale;        ///< 以格子中心缩放
+    float offsetX;      ///< 动画偏移 X（像素）
+    float offsetY;      ///< 动画偏移 Y（像素）
+    float alpha;        ///< 透明度
+};
+
+/**
+ * @brief 运动中的精灵（阶段开始时上传一次，位置由着色器按进度求出）
+ */
+struct MotionInstance {
+    float fromCol, fromRow;     ///< 起点（格子坐标，可在棋盘外）
+    float toCol, toRow;         ///< 终点（格子坐标）
+    float type;                 ///< 图集精灵索引
+    float special;              ///< SpecialType
+    float delay;                ///< 起始延迟（占阶段进度的比例）
+    float easing;               ///< BoardRenderer::MotionEasing
+};
+
+/**
+ * @brief 批量棋盘渲染器（VBO + 实例化绘制）
+ *
+ * 职责：
+ * - 收集一帧内的格子背景、水果和纯色矩形，统一提交到 GPU
+ * - 所有精灵来自同一张图集纹理，格子背景与水果一次 glDrawArraysInstanced
+ * - 纯色矩形（边框、选中框、炸弹特效）合并为一次 glDrawArrays
+ *
+ * 提交顺序即绘制顺序：精灵与矩形交替提交时自动分段刷新。
+ * 静态层（边框、格子背景、未参与动画的水果）可录制到 FBO 缓存，
+ * 之后每帧只需一次 glBlitFramebuffer，再叠加动画中的格子。
+ *
+ * 交换与下落：每个阶段开始时把全部运动（起点、终点、延迟、缓动）一次性交给 setMotions，
+ * 之后每帧只需 drawMotions(progress)，插值在顶点着色器中完成。
+ *
+ * 大地图：视口外的格子在提交时剔除；格子小于 LOD_CELL_PIXELS 时改用低细节模式
+ * （水果画成调色板纯色块，特殊标记简化为中心圆点）。
+ * 所有方法必须在 OpenGL 上下文中调用。
+ */
+class BoardRenderer : protected QOpenGLExtraFunctions
+{
+public:
+    BoardRenderer();
+    ~BoardRenderer();
+
+    /**
+     * @brief 图集精灵索引（与着色器中的 UV 表一致）
+     */
+    enum AtlasSprite {
+        SPRITE_APPLE = 0,
+        SPRITE_ORANGE,
+        SPRITE_GRAPE,
+        SPRITE_BANANA,
+        SPRITE_WATERMELON,
+        SPRITE_STRAWBERRY,
+        SPRITE_CANDY,
+        SPRITE_HAMMER,
+        SPRITE_CLAMP,
+        SPRITE_MAGIC_WAND,
+        SPRITE_COUNT
+    };
+
+    /**
+     * @brief 格子范围（行列均为左闭右开）
+     */
+    struct CellRange {
+        int rowBegin = 0;
+        int rowEnd = 0;
+        int colBegin = 0;
+        int colEnd = 0;
+    };
+
+    /**
+     * @brief 运动缓动方式（与运动着色器中的常量一致）
+     */
+    enum MotionEasing {
+        EASE_LINEAR = 0,        ///< 匀速从起点到终点
+        EASE_PING_PONG          ///< 前半程出去，后半程回到起点（交换失败回弹）
+    };
+
+    static constexpr float LOD_CELL_PIXELS = 14.0f;  ///< 格子边长小于该值时使用低细节模式
+
+    /**
+     * @brief 编译着色器、创建缓冲并加载图集
+     * @return 是否成功
+     */
+    bool initialize();
+
+    /**
+     * @brief 释放所有 GPU 资源（上下文销毁前调用）
+     */
+    void cleanup();
+
+    /**
+     * @brief 开始一帧（设置投影与网格参数）
+     */
+    void beginFrame(int viewportWidth, int viewportHeight,
+                    float gridStartX, float gridStartY, float cellSize, int mapSize);
+
+    /**
+     * @brief 视口内可见的格子范围（beginFrame 时计算）
+     */
+    CellRange visibleCells() const { return visibleCells_; }
+
+    /**
+     * @brief 本帧是否为低细节模式
+     */
+    bool isLowDetail() const { return cellSize_ < LOD_CELL_PIXELS; }
+
+    /**
+     * @brief 添加可见范围内的格子背景
+     */
+    void addCellBackgrounds();
+
+    /**
+     * @brief 添加一个水果（含特殊标记外框；完全在视口外时忽略）
+     */
+    void addFruit(int row, int col, const Fruit& fruit,
+                  float offsetX = 0.0f, float offsetY = 0.0f,
+                  float alpha = 1.0f, float scale = 1.0f);
+
+    /**
+     * @brief 添加纯色矩形
+     */
+    void addRect(float x, float y, float width, float height, const QVector4D& color);
+
+    /**
+     * @brief 添加矩形边框（向内描边）
+     */
+    void addRectOutline(float x, float y, float width, float height,
+                        float lineWidth, const QVector4D& color);
+
+    /**
+     * @brief 提交所有待绘制内容
+     */
+    void flush();
+
+    /**
+     * @brief 生成一个运动实例
+     * @return 水果不可绘制（空位等）时返回 false
+     */
+    static bool makeMotion(const Fruit& fruit, float fromRow, float fromCol, int toRow, int toCol,
+                           MotionEasing easing, float delay, MotionInstance& motion);
+
+    /**
+     * @brief 替换当前阶段的运动列表（下一次 drawMotions 时上传，可在上下文外调用）
+     */
+    void setMotions(std::vector<MotionInstance> motions);
+
+    /**
+     * @brief 按阶段进度绘制全部运动（一次实例化绘制，CPU 不逐个计算位置）
+     * @param progress 阶段进度 [0, 1]
+     */
+    void drawMotions(float progress);
+
+    /**
+     * @brief 标记静态层缓存失效（下次绘制前需重新录制）
+     */
+    void invalidateStaticLayer() { staticLayerValid_ = false; }
+
+    /**
+     * @brief 静态层是否需要重新录制（已失效或帧缓冲尺寸变化；该尺寸下 FBO 创建失败过则不再尝试）
+     * @param pixelWidth 帧缓冲宽度（设备像素）
+     * @param pixelHeight 帧缓冲高度（设备像素）
+     */
+    bool needsStaticLayerUpdate(int pixelWidth, int pixelHeight) const;
+
+    /**
+     * @brief 开始录制静态层：之后提交的内容绘制到 FBO 中（先用当前清屏色清空）
+     * @return FBO 是否可用（失败时调用方应直接绘制到屏幕）
+     */
+    bool beginStaticLayer(int pixelWidth, int pixelHeight);
+
+    /**
+     * @brief 结束录制，恢复原帧缓冲与视口
+     */
+    void endStaticLayer();
+
+    /**
+     * @brief 将静态层整体复制到当前帧缓冲（替代清屏）
+     * @return 是否有可用的静态层
+     */
+    bool compositeStaticLayer();
+
+    /**
+     * @brief 本帧已发出的绘制调用数
+     */
+    int drawCallCount() const { return drawCalls_; }
+
+private:
+    /**
+     * @brief 纯色矩形顶点
+     */
+    struct ColorVertex {
+        float x, y;
+        float r, g, b, a;
+    };
+
+    bool buildPrograms();
+    void uploadMotions();
+    bool loadAtlas();
+    void flushSprites();
+    void flushRects();
+
+    static int spriteIndexFor(FruitType type);
+
+    QOpenGLShaderProgram spriteProgram_;         ///< 实例化精灵着色器
+    QOpenGLShaderProgram colorProgram_;          ///< 纯色矩形着色器
+    QOpenGLShaderProgram motionProgram_;         ///< 运动精灵着色器（与精灵共用片段着色器）
+    QOpenGLVertexArrayObject spriteVao_;
+    QOpenGLVertexArrayObject colorVao_;
+    QOpenGLVertexArrayObject motionVao_;
+    QOpenGLBuffer quadBuffer_;                   ///< 单位四边形（4 个顶点）
+    QOpenGLBuffer instanceBuffer_;               ///< 精灵实例数据（每帧重写）
+    QOpenGLBuffer colorBuffer_;                  ///< 纯色矩形顶点（每帧重写）
+    QOpenGLBuffer motionBuffer_;                 ///< 运动实例（每个阶段上传一次）
+
+    QOpenGLTexture* atlasTexture_ = nullptr;     ///< 水果 + 道具图集
+    QOpenGLTexture* paletteTexture_ = nullptr;   ///< 每个精灵的平均色（SPRITE_COUNT x 1，低细节模式用）
+    QOpenGLFramebufferObject* staticLayer_ = nullptr;  ///< 静态层缓存
+    bool staticLayerValid_ = false;              ///< 静态层内容是否最新
+    bool staticLayerUnsupported_ = false;        ///< FBO 创建失败（尺寸变化前不再重试）
+    int unsupportedWidth_ = 0;                   ///< 创建失败时的帧缓冲尺寸
+    int unsupportedHeight_ = 0;
+    GLint savedFramebuffer_ = 0;                 ///< 录制静态层前绑定的帧缓冲
+    GLint savedViewport_[4] = { 0, 0, 0, 0 };    ///< 录制静态层前的视口
+
+    /// 待绘制实例：[0] 为格子背景，[1] 为精灵（背景先画，两者合并为一次绘制）
+    std::array<std::vector<SpriteInstance>, 2> spriteBuckets_;
+    std::vector<SpriteInstance> uploadScratch_;  ///< 合并上传用的临时数组
+    std::vector<ColorVertex> rectVertices_;      ///< 待绘制的纯色矩形
+    std::vector<MotionInstance> motions_;        ///< 当前阶段的运动
+    bool motionsDirty_ = false;                  ///< 运动列表变化后需要重新上传
+
+    QMatrix4x4 projection_;
+    float gridStartX_ = 0.0f;
+    float gridStartY_ = 0.0f;
+    float cellSize_ = 0.0f;
+    int mapSize_ = MAP_SIZE;
+    int viewportWidth_ = 0;
+    int viewportHeight_ = 0;
+    CellRange visibleCells_;
+    int drawCalls_ = 0;
+    bool initialized_ = false;
+};
+
+#endif // BOARDRENDERER_H
@@ -3,7 +3,9 @@
 #include "EliminationAnimationRenderer.h"
 #include "FallAnimationRenderer.h"
 #include "ShuffleAnimationRenderer.h"
-#include "ScoreFloatOverlay.h"
+#include "ScorePopupRenderer.h"
+#include "BoardRenderer.h"
+#include "ParticleRenderer.h"
 #include <QDebug>
 #include <QOpenGLFunctions>
 #include <cmath>
@@ -15,17 +17,18 @@
 GameView::GameView(QWidget *parent)
     : QOpenGLWidget(parent)
     , gameEngine_(nullptr)
+    , boardRenderer_(nullptr)
+    , particleRenderer_(nullptr)
     , gridStartX_(0.1f)
     , gridStartY_(0.1f)
     , cellSize_(0.1f)
-    , animationFrame_(0)
     , animController_(nullptr)
     , snapshotManager_(nullptr)
     , swapRenderer_(nullptr)
     , eliminationRenderer_(nullptr)
     , fallRenderer_(nullptr)
     , shuffleRenderer_(nullptr)
-    , scoreOverlay_(nullptr)
+    , scorePopups_(nullptr)
     , selectedRow_(-1)
     , selectedCol_(-1)
     , hasSelection_(false)
@@ -33,28 +36,27 @@ GameView::GameView(QWidget *parent)
     setMinimumSize(600, 600);
     
     // 创建动画系统组件
+    boardRenderer_ = new BoardRenderer();
+    particleRenderer_ = new ParticleRenderer();
     animController_ = new AnimationController();
     snapshotManager_ = new SnapshotManager();
     swapRenderer_ = new SwapAnimationRenderer();
     eliminationRenderer_ = new EliminationAnimationRenderer();
     fallRenderer_ = new FallAnimationRenderer();
     shuffleRenderer_ = new ShuffleAnimationRenderer();
-    
-    // 📌 创建独立的分数浮动覆盖层（作为子 Widget，避免 OpenGL 和 QPainter 混合）
-    scoreOverlay_ = new ScoreFloatOverlay(this);
-    scoreOverlay_->setGeometry(0, 0, width(), height());
-    scoreOverlay_->setMapInfo(MAP_SIZE, gridStartY_, cellSize_);
-    scoreOverlay_->show();
+    scorePopups_ = new ScorePopupRenderer();
     
     // 设置阶段完成回调
     animController_->setPhaseCompleteCallback([this](AnimPhase phase) {
         handlePhaseComplete(phase);
     });
     
-    // 动画定时器
-    animationTimer_ = new QTimer(this);
-    connect(animationTimer_, &QTimer::timeout, this, &GameView::onAnimationTimer);
-    animationTimer_->start(16); // ~60 FPS
+    // 帧循环：每次 swap 完成后推进动画并请求下一帧（按需启动，见 scheduleAnimationFrames）
+    connect(this, &QOpenGLWidget::frameSwapped, this, &GameView::onFrameSwapped);
+    frameWatchdog_ = new QTimer(this);
+    frameWatchdog_->setSingleShot(true);
+    frameWatchdog_->setInterval(FRAME_WATCHDOG_MS);
+    connect(frameWatchdog_, &QTimer::timeout, this, &GameView::onFrameSwapped);
     
     qDebug() << "GameView created with animation system";
 }
@@ -66,20 +68,19 @@ GameView::~GameView()
 {
     makeCurrent();
     
-    // 清理纹理
-    for (auto* texture : fruitTextures_) {
-        if (texture) {
-            delete texture;
-        }
-    }
-    fruitTextures_.clear();
+    // 清理纹理、着色器和缓冲
+    boardRenderer_->cleanup();
+    delete boardRenderer_;
+    particleRenderer_->cleanup();
+    delete particleRenderer_;
     
     // 清理动画组件
     delete swapRenderer_;
     delete eliminationRenderer_;
     delete fallRenderer_;
     delete shuffleRenderer_;
-    // scoreOverlay_ 作为子 Widget 由 Qt 自动管理，无需手动删除
+    scorePopups_->cleanup();
+    delete scorePopups_;
     delete animController_;
     delete snapshotManager_;
     
@@ -94,6 +95,8 @@ GameView::~GameView()
 void GameView::setGameEngine(GameEngine* engine)
 {
     gameEngine_ = engine;
+    boardRenderer_->invalidateStaticLayer();
+    particleRenderer_->clear();
     update();
 }
 
@@ -134,9 +137,40 @@ void GameView::setClickMode(ClickMode mode)
  */
 void GameView::updateDisplay()
 {
+    // 引擎地图在视图之外被修改，静态层需重新录制
+    boardRenderer_->invalidateStaticLayer();
     update(); // 触发重绘
 }
 
+bool GameView::isAnimating() const
+{
+    return animController_->getCurrentPhase() != AnimPhase::IDLE;
+}
+
+/**
+ * @brief 是否需要逐帧重绘
+ */
+bool GameView::needsAnimationFrames() const
+{
+    return isAnimating() || hasSelection_ || scorePopups_->isAnimating()
+        || particleRenderer_->hasLiveParticles(animationTimeMs_);
+}
+
+/**
+ * @brief 需要逐帧重绘时启动帧循环
+ */
+void GameView::scheduleAnimationFrames()
+{
+    if (needsAnimationFrames() && !frameLoopActive_) {
+        frameLoopActive_ = true;
+        framesSinceStart_ = 0;
+        frameClock_.start();
+        lastFrameNs_ = 0;
+        frameWatchdog_->start();
+        update();  // 第一帧 swap 后进入 onFrameSwapped
+    }
+}
+
 /** * @brief 获取当前地图大小
  */
 int GameView::getMapSize() const
@@ -160,17 +194,16 @@ void GameView::initializeGL()
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     
-    // 启用纹理
-    glEnable(GL_TEXTURE_2D);
-    
-    // 加载水果纹理
-    loadTextures();
-    
-    // 初始化所有动画渲染器的OpenGL函数
-    swapRenderer_->initialize();
-    eliminationRenderer_->initialize();
-    fallRenderer_->initialize();
-    shuffleRenderer_->initialize();
+    // 着色器、实例缓冲和水果纹理
+    if (!boardRenderer_->initialize()) {
+        qCritical() << "Failed to initialize board renderer";
+    }
+    if (!particleRenderer_->initialize()) {
+        qCritical() << "Failed to initialize particle renderer";
+    }
+    if (!scorePopups_->initialize()) {
+        qCritical() << "Failed to initialize score popup renderer";
+    }
     
     qDebug() << "OpenGL initialized";
 }
@@ -180,18 +213,14 @@ void GameView::initializeGL()
  */
 void GameView::updateMapLayout()
 {
-    // 重新计算网格布局
-    int w = width();
-    int h = height();
-    int minSize = qMin(w, h);
-    int mapSize = getMapSize();
-    cellSize_ = (minSize * 0.8f) / mapSize;  // 80%的空间用于网格
-    
-    float gridWidth = cellSize_ * mapSize;
-    gridStartX_ = (w - gridWidth) / 2.0f;
-    gridStartY_ = (h - gridWidth) / 2.0f;
-    
-    qDebug() << "Map layout updated: mapSize=" << mapSize << "cellSize=" << cellSize_;
+    // 地图大小变化后相机复位，重新计算网格布局
+    zoom_ = 1.0f;
+    panX_ = 0.0f;
+    panY_ = 0.0f;
+    applyCamera();
+    
+    qDebug() << "Map layout updated: mapSize=" << getMapSize() << "cellSize=" << cellSize_;
+    particleRenderer_->clear();  // 发射器按格子定位，地图大小变化后失效
     update();  // 触发重绘
 }
 
@@ -202,19 +231,8 @@ void GameView::resizeGL(int w, int h)
 {
     glViewport(0, 0, w, h);
     
-    // 计算网格布局
-    int minSize = qMin(w, h);
-    int mapSize = getMapSize();
-    cellSize_ = (minSize * 0.8f) / mapSize;  // 80%的空间用于网格
-    
-    float gridWidth = cellSize_ * mapSize;
-    gridStartX_ = (w - gridWidth) / 2.0f;
-    gridStartY_ = (h - gridWidth) / 2.0f;
-    
-    // 📌 同步更新分数覆盖层大小
-    if (scoreOverlay_) {
-        scoreOverlay_->setGeometry(0, 0, w, h);
-    }
+    // 计算网格布局（保留当前缩放与平移）
+    applyCamera();
     
     qDebug() << "Resized:" << w << "x" << h << "Cell size:" << cellSize_;
 }
@@ -224,34 +242,42 @@ void GameView::resizeGL(int w, int h)
  */
 void GameView::paintGL()
 {
-    // 清空屏幕
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-    
-    // 设置2D正交投影
-    glMatrixMode(GL_PROJECTION);
-    glLoadIdentity();
-    glOrtho(0, width(), height(), 0, -1, 1);
+    // 2D正交投影与网格参数
+    boardRenderer_->beginFrame(width(), height(), gridStartX_, gridStartY_, cellSize_, getMapSize());
     
-    glMatrixMode(GL_MODELVIEW);
-    glLoadIdentity();
+    // 1. 快照或隐藏集合变化后，静态层需重新录制
+    bool fromSnapshot = isShowingSnapshot();
+    if (snapshotManager_->getRevision() != staticLayerRevision_ || fromSnapshot != staticLayerFromSnapshot_) {
+        staticLayerRevision_ = snapshotManager_->getRevision();
+        staticLayerFromSnapshot_ = fromSnapshot;
+        boardRenderer_->invalidateStaticLayer();
+    }
     
-    // 绘制网格背景（奶油风格边框）
-    glDisable(GL_TEXTURE_2D);
-    glColor4f(1.0f, 0.83f, 0.71f, 1.0f);  // #FFD4B8 桃色
-    drawQuad(gridStartX_ - 10, gridStartY_ - 10, cellSize_ * getMapSize() + 20);
+    // 2. 静态层录制到 FBO，每帧整体复制（FBO 不可用时直接绘制）
+    //    像素尺寸与 QOpenGLWidget 默认帧缓冲一致（QSize * dpr 四舍五入），分数缩放时不截断
+    const qreal dpr = devicePixelRatioF();
+    const int pixelWidth = qRound(width() * dpr);
+    const int pixelHeight = qRound(height() * dpr);
+    if (boardRenderer_->needsStaticLayerUpdate(pixelWidth, pixelHeight)
+        && boardRenderer_->beginStaticLayer(pixelWidth, pixelHeight)) {
+        drawStaticLayer();
+        boardRenderer_->endStaticLayer();
+    }
+    if (!boardRenderer_->compositeStaticLayer()) {
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        drawStaticLayer();
+    }
     
-    // 绘制水果
-    if (gameEngine_) {
-        // 基础网格（使用快照或引擎地图，排除隐藏格子）
-        drawFruitGrid();
-        
-        // 根据动画阶段分发渲染
-        AnimPhase phase = animController_->getCurrentPhase();
-        if (phase != AnimPhase::IDLE) {
-            renderCurrentAnimation();
-        }
+    // 3. 动画层：只绘制隐藏集合中正在运动的格子
+    if (gameEngine_ && animController_->getCurrentPhase() != AnimPhase::IDLE) {
+        renderCurrentAnimation();
     }
     
+    // 4. 粒子特效（寿命可能超过消除阶段，与动画阶段无关）
+    boardRenderer_->flush();
+    particleRenderer_->render(width(), height(), gridStartX_, gridStartY_, cellSize_,
+                              static_cast<float>(dpr), animationTimeMs_);
+    
     // 绘制选中框（仅在空闲状态）
     if (hasSelection_ && animController_->getCurrentPhase() == AnimPhase::IDLE) {
         drawSelection();
@@ -262,75 +288,52 @@ void GameView::paintGL()
         drawPropSelection();
     }
     
-    // 📌 分数浮动显示已移至独立的 ScoreFloatOverlay，不再在此使用 QPainter
-    // 这样可以避免 OpenGL 和 QPainter 上下文切换带来的性能开销和纹理精度损失
+    // 提交本帧剩余的批次
+    boardRenderer_->flush();
+    
+    // 📌 浮动分数在最上层（字形图集，一次绘制，不再使用 QPainter 覆盖层）
+    scorePopups_->render(width(), height());
 }
 
 /**
- * @brief 加载所有水果纹理
+ * @brief 绘制静态层（边框 + 格子背景 + 未隐藏的水果）
  */
-void GameView::loadTextures()
+void GameView::drawStaticLayer()
 {
-    // 水果类型和对应的文件名
-    // 索引 0-5: 普通水果，索引 6: CANDY（彩虹糖）
-    const char* fruitFiles[] = {
-        "resources/textures/apple.png",      // APPLE = 0
-        "resources/textures/orange.png",     // ORANGE = 1
-        "resources/textures/grape.png",      // GRAPE = 2
-        "resources/textures/banana.png",     // BANANA = 3
-        "resources/textures/watermelon.png", // WATERMELON = 4
-        "resources/textures/strawberry.png", // STRAWBERRY = 5
-        "resources/textures/Candy.png"       // CANDY = 6 (彩虹糖/Rainbow)
-    };
-    
-    fruitTextures_.resize(7);  // 7 种纹理
+    // 绘制网格背景（奶油风格边框）
+    float frameSize = cellSize_ * getMapSize() + 20;
+    boardRenderer_->addRect(gridStartX_ - 10, gridStartY_ - 10, frameSize, frameSize,
+                            QVector4D(1.0f, 0.83f, 0.71f, 1.0f));  // #FFD4B8 桃色
     
-    for (int i = 0; i < 7; i++) {
-        QImage image(fruitFiles[i]);
-        if (image.isNull()) {
-            qWarning() << "Failed to load texture:" << fruitFiles[i];
-            fruitTextures_[i] = nullptr;
-            continue;
-        }
-        
-        // 转换为OpenGL格式（不需要翻转）
-        QImage glImage = image.convertToFormat(QImage::Format_RGBA8888);
-        
-        fruitTextures_[i] = new QOpenGLTexture(QOpenGLTexture::Target2D);
-        fruitTextures_[i]->setData(glImage);
-        fruitTextures_[i]->setMinificationFilter(QOpenGLTexture::Linear);
-        fruitTextures_[i]->setMagnificationFilter(QOpenGLTexture::Linear);
-        fruitTextures_[i]->setWrapMode(QOpenGLTexture::ClampToEdge);
-        
-        qDebug() << "Loaded texture:" << fruitFiles[i];
+    // 基础网格（使用快照或引擎地图，排除隐藏格子）
+    if (gameEngine_) {
+        drawFruitGrid();
     }
 }
 
+/**
+ * @brief 动画期间静态层取自快照，空闲时取自实时地图
+ */
+bool GameView::isShowingSnapshot() const
+{
+    return animController_->getCurrentPhase() != AnimPhase::IDLE && !snapshotManager_->isSnapshotEmpty();
+}
+
 /**
  * @brief 绘制水果网格（静态层，使用快照数据，排除隐藏格子）
  */
 void GameView::drawFruitGrid()
 {
     // 动画期间使用快照，空闲时使用实时地图
-    const auto& map = (animController_->getCurrentPhase() != AnimPhase::IDLE && !snapshotManager_->isSnapshotEmpty()) 
-                      ? snapshotManager_->getSnapshot() 
-                      : gameEngine_->getMap();
+    const auto& map = isShowingSnapshot() ? snapshotManager_->getSnapshot() : gameEngine_->getMap();
     
-    // 先绘制所有单元格背景（奶油白色）
-    int mapSize = getMapSize();
-    for (int row = 0; row < mapSize; row++) {
-        for (int col = 0; col < mapSize; col++) {
-            float x = gridStartX_ + col * cellSize_;
-            float y = gridStartY_ + row * cellSize_;
-            glDisable(GL_TEXTURE_2D);
-            glColor4f(1.0f, 0.96f, 0.93f, 1.0f);  // #FFF5ED 浅奶油色
-            drawQuad(x, y, cellSize_);
-        }
-    }
+    // 先绘制可见单元格背景（奶油白色，一次实例化绘制）
+    boardRenderer_->addCellBackgrounds();
     
-    // 绘制水果纹理
-    for (int row = 0; row < mapSize; row++) {
-        for (int col = 0; col < mapSize; col++) {
+    // 绘制水果纹理（只遍历视口内的行列，放大后的大地图不随总格子数变慢）
+    const BoardRenderer::CellRange visible = boardRenderer_->visibleCells();
+    for (int row = visible.rowBegin; row < visible.rowEnd; row++) {
+        for (int col = visible.colBegin; col < visible.colEnd; col++) {
             const Fruit& fruit = map[row][col];
             // 跳过空位
             if (fruit.type == FruitType::EMPTY) {
@@ -342,7 +345,7 @@ void GameView::drawFruitGrid()
                 continue;
             }
             
-            drawFruit(row, col, fruit, 0.0f, 0.0f);
+            boardRenderer_->addFruit(row, col, fruit);
         }
     }
 }
@@ -392,95 +395,11 @@ void GameView::renderCurrentAnimation()
             gridStartY_, 
             cellSize_,
             getMapSize(),
-            fruitTextures_
+            *boardRenderer_
         );
     }
 }
 
-/**
- * @brief 绘制单个水果（支持位移偏移，用于动画）
- */
-void GameView::drawFruit(int row, int col, const Fruit& fruit, float offsetX, float offsetY)
-{
-    // 计算位置
-    float x = gridStartX_ + col * cellSize_ + offsetX;
-    float y = gridStartY_ + row * cellSize_ + offsetY;
-    
-    // 获取纹理索引
-    int textureIndex = static_cast<int>(fruit.type);
-    
-    // 跳过 EMPTY 类型
-    if (fruit.type == FruitType::EMPTY) {
-        return;
-    }
-    
-    // CANDY 类型使用索引 6
-    if (fruit.type == FruitType::CANDY) {
-        textureIndex = 6;
-    }
-    
-    if (textureIndex < 0 || textureIndex >= static_cast<int>(fruitTextures_.size())) {
-        return;
-    }
-    
-    QOpenGLTexture* texture = fruitTextures_[textureIndex];
-    if (!texture) {
-        return;
-    }
-    
-    // 绘制水果纹理（调亮以适配奶油风格）
-    glEnable(GL_TEXTURE_2D);
-    texture->bind();
-    // 使用稍微增强的亮度值，让材质更明亮
-    glColor4f(1.15f, 1.15f, 1.15f, 1.0f);
-    
-    // 留出边距
-    float padding = cellSize_ * 0.1f;
-    float fruitSize = cellSize_ - padding * 2;
-    float fruitX = x + padding;
-    float fruitY = y + padding;
-    
-    glBegin(GL_QUADS);
-        glTexCoord2f(0.0f, 0.0f); glVertex2f(fruitX, fruitY);
-        glTexCoord2f(1.0f, 0.0f); glVertex2f(fruitX + fruitSize, fruitY);
-        glTexCoord2f(1.0f, 1.0f); glVertex2f(fruitX + fruitSize, fruitY + fruitSize);
-        glTexCoord2f(0.0f, 1.0f); glVertex2f(fruitX, fruitY + fruitSize);
-    glEnd();
-    
-    texture->release();
-    
-    // 如果有特殊属性，绘制标记
-    if (fruit.special != SpecialType::NONE) {
-        glDisable(GL_TEXTURE_2D);
-        
-        // 根据特殊类型选择颜色（奶油风格）
-        switch (fruit.special) {
-            case SpecialType::LINE_H:
-            case SpecialType::LINE_V:
-                glColor4f(1.0f, 0.70f, 0.28f, 0.8f);  // #FFB347 金黄色
-                break;
-            case SpecialType::DIAMOND:
-                glColor4f(0.53f, 0.81f, 1.0f, 0.8f);  // #87CEFA 浅蓝色
-                break;
-            case SpecialType::RAINBOW:
-                glColor4f(1.0f, 0.71f, 0.76f, 0.8f);  // #FFB5C2 浅粉色
-                break;
-            default:
-                break;
-        }
-        
-        // 绘制外框高亮
-        float borderSize = 4.0f;
-        glLineWidth(borderSize);
-        glBegin(GL_LINE_LOOP);
-            glVertex2f(x, y);
-            glVertex2f(x + cellSize_, y);
-            glVertex2f(x + cellSize_, y + cellSize_);
-            glVertex2f(x, y + cellSize_);
-        glEnd();
-    }
-}
-
 /**
  * @brief 绘制选中框
  */
@@ -493,37 +412,16 @@ void GameView::drawSelection()
     float x = gridStartX_ + selectedCol_ * cellSize_;
     float y = gridStartY_ + selectedRow_ * cellSize_;
     
-    glDisable(GL_TEXTURE_2D);
-    
-    // 绘制脉冲效果（奶油桃色）
-    float pulse = 0.5f + 0.5f * std::sin(animationFrame_ * 0.1f);
-    glColor4f(1.0f, 0.71f, 0.64f, 0.3f + 0.2f * pulse);  // #FFB6A3 桃色
+    // 绘制脉冲效果（奶油桃色，约 1 秒一个周期）
+    float pulse = 0.5f + 0.5f * std::sin(animationTimeMs_ * 0.00625f);
     
     // 绘制填充
-    drawQuad(x, y, cellSize_);
+    boardRenderer_->addRect(x, y, cellSize_, cellSize_,
+                            QVector4D(1.0f, 0.71f, 0.64f, 0.3f + 0.2f * pulse));  // #FFB6A3 桃色
     
     // 绘制边框（深桃色）
-    glColor4f(1.0f, 0.42f, 0.21f, 0.8f + 0.2f * pulse);  // #FF6B35 深桃色
-    glLineWidth(3.0f);
-    glBegin(GL_LINE_LOOP);
-        glVertex2f(x, y);
-        glVertex2f(x + cellSize_, y);
-        glVertex2f(x + cellSize_, y + cellSize_);
-        glVertex2f(x, y + cellSize_);
-    glEnd();
-}
-
-/**
- * @brief 绘制四边形
- */
-void GameView::drawQuad(float x, float y, float size)
-{
-    glBegin(GL_QUADS);
-        glVertex2f(x, y);
-        glVertex2f(x + size, y);
-        glVertex2f(x + size, y + size);
-        glVertex2f(x, y + size);
-    glEnd();
+    boardRenderer_->addRectOutline(x, y, cellSize_, cellSize_, 3.0f,
+                                   QVector4D(1.0f, 0.42f, 0.21f, 0.8f + 0.2f * pulse));  // #FF6B35 深桃色
 }
 
 /**
@@ -550,6 +448,13 @@ void GameView::mousePressEvent(QMouseEvent *event)
         return;
     }
     
+    // 右键/中键拖动平移相机（动画中也可用）
+    if (event->button() == Qt::RightButton || event->button() == Qt::MiddleButton) {
+        panning_ = true;
+        panAnchor_ = event->position();
+        return;
+    }
+    
     // 动画进行中时不接受新点击
     if (animController_->getCurrentPhase() != AnimPhase::IDLE) {
         return;
@@ -573,6 +478,8 @@ void GameView::mousePressEvent(QMouseEvent *event)
         }
     }
     
+    // 选中框脉冲或动画开始时启动逐帧重绘
+    scheduleAnimationFrames();
     update();
 }
 
@@ -581,7 +488,62 @@ void GameView::mousePressEvent(QMouseEvent *event)
  */
 void GameView::mouseReleaseEvent(QMouseEvent *event)
 {
-    Q_UNUSED(event);
+    if (event->button() == Qt::RightButton || event->button() == Qt::MiddleButton) {
+        panning_ = false;
+    }
+}
+
+/**
+ * @brief 滚轮缩放（以光标为中心）
+ */
+void GameView::wheelEvent(QWheelEvent *event)
+{
+    if (!gameEngine_ || !boardRenderer_) {
+        return;
+    }
+    
+    // 1. 光标下的网格坐标（格子单位），缩放后保持在光标下
+    const QPointF cursor = event->position();
+    const float gridX = (cursor.x() - gridStartX_) / cellSize_;
+    const float gridY = (cursor.y() - gridStartY_) / cellSize_;
+    
+    // 2. 缩放后按偏差修正平移
+    zoom_ *= std::pow(ZOOM_STEP, event->angleDelta().y() / 120.0f);
+    applyCamera();
+    panX_ += cursor.x() - (gridStartX_ + gridX * cellSize_);
+    panY_ += cursor.y() - (gridStartY_ + gridY * cellSize_);
+    applyCamera();
+    
+    event->accept();
+    update();
+}
+
+/**
+ * @brief 按窗口尺寸、地图大小与相机参数计算网格布局
+ */
+void GameView::applyCamera()
+{
+    const int w = width();
+    const int h = height();
+    const int mapSize = getMapSize();
+    
+    // 1. 缩放：1 倍时 80% 的空间用于网格，放大到格子约 MAX_ZOOM_CELL_PIXELS 为止
+    const float baseCellSize = (qMin(w, h) * 0.8f) / mapSize;
+    const float maxZoom = qMax(1.0f, MAX_ZOOM_CELL_PIXELS / baseCellSize);
+    zoom_ = qBound(1.0f, zoom_, maxZoom);
+    cellSize_ = baseCellSize * zoom_;
+    
+    // 2. 平移：网格大于视图时最多移到边缘对齐，否则保持居中
+    const float gridWidth = cellSize_ * mapSize;
+    const float maxPanX = qMax(0.0f, (gridWidth - w) / 2.0f);
+    const float maxPanY = qMax(0.0f, (gridWidth - h) / 2.0f);
+    panX_ = qBound(-maxPanX, panX_, maxPanX);
+    panY_ = qBound(-maxPanY, panY_, maxPanY);
+    
+    gridStartX_ = (w - gridWidth) / 2.0f + panX_;
+    gridStartY_ = (h - gridWidth) / 2.0f + panY_;
+    
+    boardRenderer_->invalidateStaticLayer();
 }
 
 /**
@@ -668,31 +630,34 @@ void GameView::handlePropClick(int row, int col)
 }
 
 /**
- * @brief 动画定时器，驱动AnimationController更新
+ * @brief 帧循环：一帧显示完成后按真实经过时间推进动画，并请求下一帧
  */
-void GameView::onAnimationTimer()
+void GameView::onFrameSwapped()
 {
-    animationFrame_++;
+    if (!frameLoopActive_) {
+        return;  // 非动画期间的单次重绘
+    }
     
-    // 更新AnimationController，检查是否有阶段完成
-    bool phaseCompleted = animController_->updateProgress();
+    // 1. 距上一帧的真实时间
+    qint64 now = frameClock_.nsecsElapsed();
+    float deltaMs = (now - lastFrameNs_) / 1000000.0f;
+    lastFrameNs_ = now;
+    framesSinceStart_++;
+    animationTimeMs_ += deltaMs;
     
-    // 📌 浮动分数动画现在由 ScoreFloatOverlay 独立管理，无需在此更新
+    // 2. 推进动画状态机（可能触发阶段完成回调）与浮动分数
+    animController_->updateProgress(deltaMs);
+    scorePopups_->advance(deltaMs);
     
-    // 空闲时仅为选中框做脉冲重绘
-    if (animController_->getCurrentPhase() == AnimPhase::IDLE) {
-        // 有选中框时需要重绘（分数覆盖层独立刷新，不影响 OpenGL）
-        if (hasSelection_) {
-            update();
-        }
+    // 3. 请求下一帧；阶段完成回调中也可能回到空闲，
+    //    此时再画最后一帧显示引擎的最终状态，然后停止帧循环
+    update();
+    if (needsAnimationFrames()) {
+        frameWatchdog_->start();
     } else {
-        // 动画期间每帧重绘
-        update();
-    }
-    
-    // 如果阶段完成，在渲染后再强制一次update确保新状态被显示
-    if (phaseCompleted) {
-        update();
+        frameLoopActive_ = false;
+        frameWatchdog_->stop();
+        qDebug() << "Frame loop idle after" << framesSinceStart_ << "frames";
     }
 }
 
@@ -710,8 +675,12 @@ void GameView::beginSwapAnimation(bool success)
     // 🔧 修复：交换动画需要隐藏原位置的水果，避免重影
     snapshotManager_->updateHiddenCells(animSeq, 0, AnimPhase::SWAPPING);
     
+    // 两个水果的运动一次性上传，之后每帧只提交进度
+    swapRenderer_->prepare(animSeq, 0, snapshotManager_->getSnapshot(), getMapSize(), *boardRenderer_);
+    
     // 开始交换动画（状态机）
     animController_->beginSwap(success);
+    scheduleAnimationFrames();
 }
 
 /**
@@ -725,44 +694,21 @@ void GameView::beginEliminationStep(int roundIndex)
     
     // 开始消除动画（状态机）
     animController_->beginElimination(roundIndex);
+    scheduleAnimationFrames();
     
     // 🔧 隐藏被消除的格子
     snapshotManager_->updateHiddenCells(animSeq, roundIndex, AnimPhase::ELIMINATING);
     
-    // 📌 添加浮动分数显示（使用独立覆盖层）
-    if (scoreOverlay_ && roundIndex >= 0 && roundIndex < static_cast<int>(animSeq.rounds.size())) {
+    // 消除粒子与炸弹特效（颜色取自消除前的快照）
+    if (roundIndex >= 0 && roundIndex < static_cast<int>(animSeq.rounds.size())) {
+        const auto& board = snapshotManager_->isSnapshotEmpty() ? gameEngine_->getMap() : snapshotManager_->getSnapshot();
+        particleRenderer_->spawnElimination(animSeq.rounds[roundIndex].elimination, board, animationTimeMs_);
+    }
+    
+    // 📌 添加浮动分数显示（固定在视图上方生成，与动画一起在 paintGL 中绘制）
+    if (roundIndex >= 0 && roundIndex < static_cast<int>(animSeq.rounds.size())) {
         const auto& round = animSeq.rounds[roundIndex];
-        if (round.scoreDelta > 0) {
-            // 计算消除区域的中心位置（屏幕坐标）
-            float centerX = 0.0f;
-            float centerY = 0.0f;
-            
-            if (!round.elimination.positions.empty()) {
-                for (const auto& pos : round.elimination.positions) {
-                    centerX += gridStartX_ + pos.second * cellSize_ + cellSize_ / 2.0f;
-                    centerY += gridStartY_ + pos.first * cellSize_ + cellSize_ / 2.0f;
-                }
-                centerX /= round.elimination.positions.size();
-                centerY /= round.elimination.positions.size();
-            } else {
-                // 默认显示在网格中心上方
-                centerX = gridStartX_ + (getMapSize() / 2.0f) * cellSize_;
-                centerY = gridStartY_ + cellSize_;
-            }
-            
-            // 🔧 限制悬浮字在地图范围内
-            float gridWidth = getMapSize() * cellSize_;
-            float minX = gridStartX_ + cellSize_;
-            float maxX = gridStartX_ + gridWidth - cellSize_;
-            float minY = gridStartY_ + cellSize_;
-            float maxY = gridStartY_ + gridWidth - cellSize_ * 2;
-            
-            centerX = std::max(minX, std::min(maxX, centerX));
-            centerY = std::max(minY, std::min(maxY, centerY));
-            
-            // 新的 API：不再传入位置，由 ScoreFloatOverlay 固定在地图顶部生成
-            scoreOverlay_->addScore(round.scoreDelta, round.comboCount);
-        }
+        scorePopups_->addScore(round.scoreDelta, round.comboCount);
     }
 }
 
@@ -781,8 +727,12 @@ void GameView::beginFallStep(int roundIndex)
     // 🔧 隐藏snapshot中即将下落的水果源位置（避免重影）
     snapshotManager_->updateHiddenCells(animSeq, roundIndex, AnimPhase::FALLING);
     
+    // 本轮全部下落运动一次性上传，之后每帧只提交进度
+    fallRenderer_->prepare(animSeq, roundIndex, snapshotManager_->getSnapshot(), getMapSize(), *boardRenderer_);
+    
     // 开始下落动画
     animController_->beginFall(roundIndex);
+    scheduleAnimationFrames();
 }
 
 /**
@@ -794,6 +744,7 @@ void GameView::beginShuffleAnimation()
     
     // 开始重排动画（状态机）
     animController_->beginShuffle();
+    scheduleAnimationFrames();
     
     // 隐藏所有格子
     snapshotManager_->hideAllCells();
@@ -956,6 +907,16 @@ void GameView::cancelProp()
  */
 void GameView::mouseMoveEvent(QMouseEvent *event)
 {
+    if (panning_) {
+        const QPointF delta = event->position() - panAnchor_;
+        panAnchor_ = event->position();
+        panX_ += delta.x();
+        panY_ += delta.y();
+        applyCamera();
+        update();
+        return;
+    }
+    
     if (propState_ == PropState::HOLDING) {
         // 道具持有状态，重绘以显示跟随效果
         update();
@@ -967,8 +928,6 @@ void GameView::mouseMoveEvent(QMouseEvent *event)
  */
 void GameView::drawPropSelection()
 {
-    glDisable(GL_TEXTURE_2D);
-    
     // 绘制第一个选中框
     if (propState_ == PropState::FIRST_SELECTED || propState_ == PropState::READY) {
         if (propTargetRow1_ >= 0 && propTargetCol1_ >= 0) {
@@ -976,26 +935,21 @@ void GameView::drawPropSelection()
             float y = gridStartY_ + propTargetRow1_ * cellSize_;
             
             // 根据道具类型选择颜色（奶油风格）
+            QVector4D fillColor;
             if (heldPropType_ == ClickMode::PROP_HAMMER) {
-                glColor4f(0.96f, 0.87f, 0.70f, 0.6f);  // #F5DEB3 小麦色
+                fillColor = QVector4D(0.96f, 0.87f, 0.70f, 0.6f);  // #F5DEB3 小麦色
             } else if (heldPropType_ == ClickMode::PROP_CLAMP) {
-                glColor4f(0.68f, 0.85f, 0.90f, 0.6f);  // #AED9E6 浅蓝色
+                fillColor = QVector4D(0.68f, 0.85f, 0.90f, 0.6f);  // #AED9E6 浅蓝色
             } else if (heldPropType_ == ClickMode::PROP_MAGIC_WAND) {
-                glColor4f(0.93f, 0.79f, 0.93f, 0.6f);  // #EDC9ED 浅紫色
+                fillColor = QVector4D(0.93f, 0.79f, 0.93f, 0.6f);  // #EDC9ED 浅紫色
             }
             
             // 绘制填充
-            drawQuad(x, y, cellSize_);
+            boardRenderer_->addRect(x, y, cellSize_, cellSize_, fillColor);
             
             // 绘制边框（桃色）
-            glColor4f(1.0f, 0.42f, 0.21f, 0.9f);  // #FF6B35
-            glLineWidth(4.0f);
-            glBegin(GL_LINE_LOOP);
-                glVertex2f(x, y);
-                glVertex2f(x + cellSize_, y);
-                glVertex2f(x + cellSize_, y + cellSize_);
-                glVertex2f(x, y + cellSize_);
-            glEnd();
+            boardRenderer_->addRectOutline(x, y, cellSize_, cellSize_, 4.0f,
+                                           QVector4D(1.0f, 0.42f, 0.21f, 0.9f));  // #FF6B35
         }
     }
     
@@ -1005,17 +959,11 @@ void GameView::drawPropSelection()
             float x = gridStartX_ + propTargetCol2_ * cellSize_;
             float y = gridStartY_ + propTargetRow2_ * cellSize_;
             
-            glColor4f(0.68f, 0.85f, 0.90f, 0.6f);  // #AED9E6 浅蓝色
-            drawQuad(x, y, cellSize_);
+            boardRenderer_->addRect(x, y, cellSize_, cellSize_,
+                                    QVector4D(0.68f, 0.85f, 0.90f, 0.6f));  // #AED9E6 浅蓝色
             
-            glColor4f(1.0f, 0.42f, 0.21f, 0.9f);  // #FF6B35 桃色边框
-            glLineWidth(4.0f);
-            glBegin(GL_LINE_LOOP);
-                glVertex2f(x, y);
-                glVertex2f(x + cellSize_, y);
-                glVertex2f(x + cellSize_, y + cellSize_);
-                glVertex2f(x, y + cellSize_);
-            glEnd();
+            boardRenderer_->addRectOutline(x, y, cellSize_, cellSize_, 4.0f,
+                                           QVector4D(1.0f, 0.42f, 0.21f, 0.9f));  // #FF6B35 桃色边框
         }
     }
 }
@@ -3,9 +3,10 @@
 
 #include <QOpenGLWidget>
 #include <QOpenGLFunctions>
-#include <QOpenGLTexture>
 #include <QTimer>
+#include <QElapsedTimer>
 #include <QMouseEvent>
+#include <QWheelEvent>
 #include <vector>
 #include <array>
 #include <set>
@@ -21,7 +22,9 @@ class SwapAnimationRenderer;
 class EliminationAnimationRenderer;
 class FallAnimationRenderer;
 class ShuffleAnimationRenderer;
-class ScoreFloatOverlay;
+class ScorePopupRenderer;
+class BoardRenderer;
+class ParticleRenderer;
 
 /**
  * @brief 道具交互状态（注意：这是GameView内部使用的枚举，与InputHandler中的PropInteractionState不同）
@@ -36,7 +39,17 @@ enum class PropState {
 /**
  * @brief 游戏OpenGL渲染视图
  * 
- * 使用OpenGL渲染8×8水果地图，支持纹理显示和动画效果
+ * 使用OpenGL渲染水果地图，支持纹理显示和动画效果
+ * 所有绘制经 BoardRenderer 批量提交（实例化绘制，不使用固定管线）
+ *
+ * 按需重绘：帧循环只在动画阶段非 IDLE、选中框脉冲或浮动分数显示时运行，
+ * 其余情况由输入和引擎变化触发单次 update()。静止棋盘上不产生任何定时唤醒和重绘。
+ *
+ * 帧循环由 frameSwapped 驱动（与显示器刷新同步），每帧按单调时钟的真实间隔推进动画，
+ * 掉帧时动画时长不变，也不会比屏幕刷新跑得更快。
+ *
+ * 相机：滚轮以光标为中心缩放，右键/中键拖动平移。缩放平移只改变网格布局参数，
+ * 点击判定与各渲染器自动跟随；视口外的格子由 BoardRenderer 剔除。
  */
 class GameView : public QOpenGLWidget, protected QOpenGLFunctions
 {
@@ -61,6 +74,11 @@ public:
      * @return 当前模式
      */
     ClickMode getClickMode() const { return clickMode_; }
+    
+    /**
+     * @brief 是否正在播放动画
+     */
+    bool isAnimating() const;
 
 protected:
     void initializeGL() override;
@@ -69,15 +87,13 @@ protected:
     void mousePressEvent(QMouseEvent *event) override;
     void mouseReleaseEvent(QMouseEvent *event) override;
     void mouseMoveEvent(QMouseEvent *event) override;
+    void wheelEvent(QWheelEvent *event) override;
 
 private slots:
-    void onAnimationTimer();
+    void onFrameSwapped();
 
 private:
-    // ========== 纹理 & 绘制基础 ==========
-    void loadTextures();
-    void drawQuad(float x, float y, float size);
-    void drawFruit(int row, int col, const Fruit& fruit, float offsetX = 0.0f, float offsetY = 0.0f);
+    // ========== 绘制基础 ==========
     void drawSelection();
     bool screenToGrid(int x, int y, int& row, int& col);
     
@@ -95,7 +111,9 @@ private:
     void drawPropSelection();
     
     // ========== 渲染 ==========
+    void drawStaticLayer();         ///< 静态层：边框 + 格子背景 + 未隐藏的水果
     void drawFruitGrid();           ///< 静态水果层
+    bool isShowingSnapshot() const; ///< 静态层是否取自快照（否则取自引擎地图）
     void renderCurrentAnimation();  ///< 当前动画阶段渲染分发器
     
     // ========== 动画阶段控制 ==========
@@ -114,18 +132,45 @@ private:
     /// 获取当前地图大小
     int getMapSize() const;
     
+    /// 按窗口尺寸、地图大小与相机参数计算网格布局
+    void applyCamera();
+    
+    /// 是否需要逐帧重绘（动画进行中、选中框脉冲、浮动分数或粒子）
+    bool needsAnimationFrames() const;
+    /// 需要逐帧重绘时启动帧循环（已在运行则不变）
+    void scheduleAnimationFrames();
+    
     // ========== 引擎和基础 ==========
     GameEngine* gameEngine_;
-    std::vector<QOpenGLTexture*> fruitTextures_;
+    BoardRenderer* boardRenderer_;              ///< 批量渲染器（持有纹理与着色器）
+    ParticleRenderer* particleRenderer_;        ///< GPU 粒子特效（消除与炸弹）
     
     // 网格布局参数
     float gridStartX_;
     float gridStartY_;
     float cellSize_;
     
-    // 动画定时器 & 帧计数
-    QTimer* animationTimer_;
-    int animationFrame_;
+    // 相机（缩放 1 倍时整张地图占视图 80%，居中）
+    float zoom_ = 1.0f;                         ///< 缩放倍数
+    float panX_ = 0.0f;                         ///< 相对居中位置的平移（像素）
+    float panY_ = 0.0f;
+    bool panning_ = false;                      ///< 是否正在拖动平移
+    QPointF panAnchor_;                         ///< 上一次拖动的鼠标位置
+    static constexpr float ZOOM_STEP = 1.15f;               ///< 滚轮每格的缩放比例
+    static constexpr float MAX_ZOOM_CELL_PIXELS = 96.0f;    ///< 放大上限（格子边长，像素）
+    
+    // 静态层缓存的数据来源（与当前不一致时重新录制）
+    unsigned int staticLayerRevision_ = 0;      ///< 录制时的快照修订号
+    bool staticLayerFromSnapshot_ = false;      ///< 录制时是否取自快照
+    
+    // 帧循环 & 动画时钟
+    QElapsedTimer frameClock_;                  ///< 单调时钟（帧循环启动时重新计时）
+    qint64 lastFrameNs_ = 0;                    ///< 上一帧的时钟读数（纳秒）
+    bool frameLoopActive_ = false;              ///< 帧循环是否运行中
+    QTimer* frameWatchdog_;                     ///< 窗口不可见（不再 swap）时兜底推进动画
+    float animationTimeMs_ = 0.0f;              ///< 累计动画时间（选中框脉冲用）
+    int framesSinceStart_ = 0;                  ///< 本次帧循环的帧数（停止时输出日志）
+    static constexpr int FRAME_WATCHDOG_MS = 100; ///< 超过该时间没有新帧则直接推进
     
     // ========== 动画系统（解耦组件）==========
     AnimationController* animController_;       ///< 动画状态机控制器
@@ -134,7 +179,7 @@ private:
     EliminationAnimationRenderer* eliminationRenderer_; ///< 消除动画渲染器
     FallAnimationRenderer* fallRenderer_;       ///< 下落动画渲染器
     ShuffleAnimationRenderer* shuffleRenderer_; ///< 重排动画渲染器
-    ScoreFloatOverlay* scoreOverlay_;           ///< 分数浮动覆盖层（独立 Widget）
+    ScorePopupRenderer* scorePopups_;           ///< 浮动分数（字形图集，GL 内绘制）
     
     // ========== 选中和道具状态 ==========
     int selectedRow_;
@@ -0,0 +1,323 @@
+#include "ParticleRenderer.h"
+#include <QMatrix4x4>
+#include <QDebug>
+#include <algorithm>
+
+namespace {
+
+// 粒子位置 = 发射点 + 速度 * t + 重力，全部由发射器参数与粒子序号在着色器中求出
+const char* const PARTICLE_VERTEX_SHADER = R"(
+    #version 330 core
+    layout(location = 0) in vec4 a_emitter;     // 列, 行, 类型, 范围
+    layout(location = 1) in vec4 a_colorTime;   // r, g, b, 生成时间（毫秒）
+
+    uniform mat4 u_projection;
+    uniform vec2 u_gridOrigin;
+    uniform float u_cellSize;
+    uniform float u_pixelRatio;                 // 点大小以帧缓冲像素计，需乘设备像素比
+    uniform float u_time;
+
+    out vec4 v_color;
+
+    const int EMITTER_CELL = 0;
+    const int EMITTER_LINE_H = 1;
+    const int EMITTER_LINE_V = 2;
+    const int EMITTER_DIAMOND = 3;
+    const int EMITTER_RAINBOW = 4;
+    const float GRAVITY = 6.0;                  // 格/秒²
+    const float TAU = 6.2831853;
+
+    float hash(float n)
+    {
+        return fract(sin(n) * 43758.5453123);
+    }
+
+    vec3 hueToRgb(float hue)
+    {
+        vec3 k = abs(fract(vec3(hue) + vec3(0.0, 2.0 / 3.0, 1.0 / 3.0)) * 6.0 - 3.0);
+        return clamp(k - 1.0, 0.0, 1.0);
+    }
+
+    void main()
+    {
+        int kind = int(a_emitter.z + 0.5);
+        int count = (kind == EMITTER_CELL) ? 12 : (kind == EMITTER_DIAMOND ? 48 : 64);
+
+        // 每个粒子的随机数：粒子序号 + 发射器位置 + 生成时间
+        float seed = float(gl_VertexID) * 12.9898 + a_emitter.x * 78.233 + a_emitter.y * 37.719
+                   + a_colorTime.w * 0.0137;
+        float r1 = hash(seed);
+        float r2 = hash(seed + 1.0);
+        float r3 = hash(seed + 2.0);
+        float r4 = hash(seed + 3.0);
+
+        float delay = r4 * 80.0;
+        float life = mix(450.0, 800.0, r3);
+        float age = u_time - a_colorTime.w - delay;
+        float t = age / life;
+
+        if (gl_VertexID >= count || t < 0.0 || t > 1.0) {
+            gl_Position = vec4(2.0, 2.0, 2.0, 1.0);   // 裁剪掉
+            gl_PointSize = 0.0;
+            v_color = vec4(0.0);
+            return;
+        }
+
+        vec2 origin = a_emitter.xy + vec2(0.5);     // 格子中心（格子单位）
+        vec2 velocity;                              // 格/秒
+        float gravity = GRAVITY;
+        vec3 color = a_colorTime.rgb;
+        float size = mix(0.22, 0.10, t);
+
+        if (kind == EMITTER_LINE_H) {
+            origin.x = r1 * a_emitter.w;
+            velocity = vec2((r2 - 0.5) * 0.8, (r3 < 0.5 ? -1.0 : 1.0) * mix(0.8, 2.5, r2));
+            gravity = 0.0;
+        } else if (kind == EMITTER_LINE_V) {
+            origin.y = r1 * a_emitter.w;
+            velocity = vec2((r3 < 0.5 ? -1.0 : 1.0) * mix(0.8, 2.5, r2), (r2 - 0.5) * 0.8);
+            gravity = 0.0;
+        } else if (kind == EMITTER_DIAMOND) {
+            float angle = r1 * TAU;
+            velocity = vec2(cos(angle), sin(angle)) * (a_emitter.w + 0.5) * mix(1.4, 1.8, r2);
+            gravity = 0.0;
+            size = mix(0.28, 0.12, t);
+        } else if (kind == EMITTER_RAINBOW) {
+            origin = vec2(r1, r2) * a_emitter.w;
+            velocity = vec2((r3 - 0.5) * 0.6, -mix(0.3, 1.2, r4));
+            gravity = 0.0;
+            color = hueToRgb(fract(r1 + r2 + u_time * 0.001));
+        } else {
+            float angle = r1 * TAU;
+            velocity = vec2(cos(angle), sin(angle)) * mix(1.0, 3.0, r2) - vec2(0.0, 1.0);
+        }
+
+        float seconds = age / 1000.0;
+        vec2 position = origin + velocity * seconds + vec2(0.0, 0.5 * gravity * seconds * seconds);
+
+        gl_Position = u_projection * vec4(u_gridOrigin + position * u_cellSize, 0.0, 1.0);
+        gl_PointSize = max(1.0, u_cellSize * u_pixelRatio * size * (0.6 + 0.4 * r2));
+        v_color = vec4(color, 1.0 - t * t);
+    }
+)";
+
+// 圆形软边粒子
+const char* const PARTICLE_FRAGMENT_SHADER = R"(
+    #version 330 core
+    in vec4 v_color;
+    out vec4 fragColor;
+
+    void main()
+    {
+        float falloff = 1.0 - smoothstep(0.2, 0.5, length(gl_PointCoord - vec2(0.5)));
+        if (falloff <= 0.0) {
+            discard;
+        }
+        fragColor = vec4(v_color.rgb, v_color.a * falloff);
+    }
+)";
+
+/**
+ * @brief 水果对应的粒子颜色
+ */
+void fruitParticleColor(FruitType type, float& r, float& g, float& b)
+{
+    switch (type) {
+        case FruitType::APPLE:      r = 0.95f; g = 0.25f; b = 0.25f; break;
+        case FruitType::ORANGE:     r = 1.0f;  g = 0.60f; b = 0.10f; break;
+        case FruitType::GRAPE:      r = 0.60f; g = 0.30f; b = 0.85f; break;
+        case FruitType::BANANA:     r = 1.0f;  g = 0.85f; b = 0.20f; break;
+        case FruitType::WATERMELON: r = 0.30f; g = 0.80f; b = 0.35f; break;
+        case FruitType::STRAWBERRY: r = 1.0f;  g = 0.35f; b = 0.50f; break;
+        case FruitType::CANDY:      r = 1.0f;  g = 0.50f; b = 0.85f; break;
+        default:                    r = 1.0f;  g = 0.83f; b = 0.71f; break;  // #FFD4B8 桃色
+    }
+}
+
+} // namespace
+
+ParticleRenderer::ParticleRenderer()
+    : emitterBuffer_(QOpenGLBuffer::VertexBuffer)
+{
+}
+
+ParticleRenderer::~ParticleRenderer()
+{
+    // GPU 资源须由持有者在上下文有效时调用 cleanup() 释放
+}
+
+/**
+ * @brief 初始化 GPU 资源
+ */
+bool ParticleRenderer::initialize()
+{
+    initializeOpenGLFunctions();
+
+    if (!program_.addShaderFromSourceCode(QOpenGLShader::Vertex, PARTICLE_VERTEX_SHADER)
+        || !program_.addShaderFromSourceCode(QOpenGLShader::Fragment, PARTICLE_FRAGMENT_SHADER)
+        || !program_.link()) {
+        qCritical() << "Failed to build particle shader:" << program_.log();
+        return false;
+    }
+
+    // 只有每实例属性：粒子序号来自 gl_VertexID
+    vao_.create();
+    vao_.bind();
+
+    emitterBuffer_.create();
+    emitterBuffer_.setUsagePattern(QOpenGLBuffer::DynamicDraw);
+    emitterBuffer_.bind();
+    glEnableVertexAttribArray(0);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(Emitter), nullptr);
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(Emitter),
+                          reinterpret_cast<const void*>(4 * sizeof(float)));
+    glVertexAttribDivisor(0, 1);
+    glVertexAttribDivisor(1, 1);
+
+    vao_.release();
+    emitterBuffer_.release();
+
+    initialized_ = true;
+    qDebug() << "ParticleRenderer initialized";
+    return true;
+}
+
+void ParticleRenderer::cleanup()
+{
+    if (initialized_) {
+        vao_.destroy();
+        emitterBuffer_.destroy();
+        program_.removeAllShaders();
+        initialized_ = false;
+    }
+    emitters_.clear();
+}
+
+/**
+ * @brief 为一轮消除生成发射器
+ */
+void ParticleRenderer::spawnElimination(const EliminationStep& step,
+                                        const std::vector<std::vector<Fruit>>& board,
+                                        float timeMs)
+{
+    // 1. 列表为空时重置时间基准
+    if (emitters_.empty()) {
+        epochMs_ = timeMs;
+    }
+    const float startTime = timeMs - epochMs_;
+    const int mapSize = static_cast<int>(board.size());
+
+    // 2. 每个被消除的格子一个小爆发（颜色取自消除前的水果）
+    for (size_t i = 0; i < step.positions.size(); ++i) {
+        int row = step.positions[i].first;
+        int col = step.positions[i].second;
+        if (row < 0 || row >= mapSize || col < 0 || col >= mapSize) {
+            continue;
+        }
+
+        FruitType type = board[row][col].type;
+        if (type == FruitType::EMPTY && i < step.types.size()) {
+            type = step.types[i];
+        }
+
+        float r, g, b;
+        fruitParticleColor(type, r, g, b);
+        addEmitter(col, row, EMITTER_CELL, 0.0f, r, g, b, startTime);
+    }
+
+    // 3. 炸弹特效（颜色与特殊元素外框一致）
+    for (const auto& effect : step.bombEffects) {
+        switch (effect.type) {
+            case BombEffectType::LINE_H:
+                addEmitter(0.0f, effect.row, EMITTER_LINE_H, mapSize, 1.0f, 0.70f, 0.28f, startTime);  // #FFB347
+                break;
+            case BombEffectType::LINE_V:
+                addEmitter(effect.col, 0.0f, EMITTER_LINE_V, mapSize, 1.0f, 0.70f, 0.28f, startTime);  // #FFB347
+                break;
+            case BombEffectType::DIAMOND:
+                addEmitter(effect.col, effect.row, EMITTER_DIAMOND, effect.range, 0.53f, 0.81f, 1.0f, startTime);  // #87CEFA
+                break;
+            case BombEffectType::RAINBOW:
+                // 全盘闪光，按地图大小多放几组
+                for (int i = 0; i < std::max(1, mapSize * mapSize / 64); ++i) {
+                    addEmitter(i, 0.0f, EMITTER_RAINBOW, mapSize, 1.0f, 1.0f, 1.0f, startTime);
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+    latestStartMs_ = startTime;
+}
+
+void ParticleRenderer::addEmitter(float col, float row, EmitterKind kind, float range,
+                                  float r, float g, float b, float startTime)
+{
+    emitters_.push_back({ col, row, static_cast<float>(kind), range, r, g, b, startTime });
+    emittersDirty_ = true;
+}
+
+/**
+ * @brief 绘制存活的粒子
+ */
+void ParticleRenderer::render(int viewportWidth, int viewportHeight,
+                              float gridStartX, float gridStartY, float cellSize,
+                              float devicePixelRatio, float timeMs)
+{
+    if (!initialized_ || emitters_.empty()) {
+        return;
+    }
+
+    // 1. 移除已结束的发射器（按发射器计算，与粒子数无关）
+    const float now = timeMs - epochMs_;
+    auto expired = std::remove_if(emitters_.begin(), emitters_.end(), [now](const Emitter& emitter) {
+        return now - emitter.startTime > MAX_LIFETIME_MS;
+    });
+    if (expired != emitters_.end()) {
+        emitters_.erase(expired, emitters_.end());
+        emittersDirty_ = true;
+    }
+    if (emitters_.empty()) {
+        return;
+    }
+
+    // 2. 发射器变化时才上传
+    if (emittersDirty_) {
+        emitterBuffer_.bind();
+        emitterBuffer_.allocate(emitters_.data(), static_cast<int>(emitters_.size() * sizeof(Emitter)));
+        emitterBuffer_.release();
+        emittersDirty_ = false;
+    }
+
+    QMatrix4x4 projection;
+    projection.ortho(0.0f, viewportWidth, viewportHeight, 0.0f, -1.0f, 1.0f);
+
+    program_.bind();
+    program_.setUniformValue("u_projection", projection);
+    program_.setUniformValue("u_gridOrigin", gridStartX, gridStartY);
+    program_.setUniformValue("u_cellSize", cellSize);
+    program_.setUniformValue("u_pixelRatio", devicePixelRatio);
+    program_.setUniformValue("u_time", now);
+
+    // 3. 每个发射器一个实例，一次绘制
+    glEnable(GL_PROGRAM_POINT_SIZE);
+    vao_.bind();
+    glDrawArraysInstanced(GL_POINTS, 0, PARTICLES_PER_EMITTER, static_cast<GLsizei>(emitters_.size()));
+    vao_.release();
+    glDisable(GL_PROGRAM_POINT_SIZE);
+
+    program_.release();
+}
+
+bool ParticleRenderer::hasLiveParticles(float timeMs) const
+{
+    return !emitters_.empty() && timeMs - epochMs_ - latestStartMs_ <= MAX_LIFETIME_MS;
+}
+
+void ParticleRenderer::clear()
+{
+    emitters_.clear();
+    emittersDirty_ = true;
+}
@@ -0,0 +1,109 @@
+#ifndef PARTICLERENDERER_H
+#define PARTICLERENDERER_H
+
+#include <QOpenGLExtraFunctions>
+#include <QOpenGLShaderProgram>
+#include <QOpenGLBuffer>
+#include <QOpenGLVertexArrayObject>
+#include <vector>
+#include "GameEngine.h"
+
+/**
+ * @brief GPU 粒子特效渲染器（消除与炸弹特效）
+ *
+ * 职责：
+ * - 按消除轮次生成发射器：每个被消除的格子一个小爆发，每个炸弹特效一个发射器
+ * - CPU 只维护发射器列表（生成时上传一次），不逐粒子计算
+ * - 粒子状态在顶点着色器中由发射器参数 + 时间解析求出：
+ *   每个发射器一个实例，实例内的 gl_VertexID 即粒子序号（用于生成随机方向与寿命）
+ *
+ * 坐标以格子为单位，窗口缩放后无需重建发射器。
+ * 所有方法必须在 OpenGL 上下文中调用（spawn / hasLiveParticles / clear 除外）。
+ */
+class ParticleRenderer : protected QOpenGLExtraFunctions
+{
+public:
+    ParticleRenderer();
+    ~ParticleRenderer();
+
+    /**
+     * @brief 编译着色器并创建缓冲
+     * @return 是否成功
+     */
+    bool initialize();
+
+    /**
+     * @brief 释放 GPU 资源（上下文销毁前调用）
+     */
+    void cleanup();
+
+    /**
+     * @brief 为一轮消除生成发射器
+     * @param step 消除步骤（被消除的格子与炸弹特效）
+     * @param board 消除前的棋盘（决定粒子颜色）
+     * @param timeMs 当前动画时间（毫秒）
+     */
+    void spawnElimination(const EliminationStep& step,
+                          const std::vector<std::vector<Fruit>>& board,
+                          float timeMs);
+
+    /**
+     * @brief 绘制所有存活的粒子（一次实例化绘制），并移除已结束的发射器
+     * @param devicePixelRatio 设备像素比（坐标为逻辑像素，点大小按帧缓冲像素换算）
+     */
+    void render(int viewportWidth, int viewportHeight,
+                float gridStartX, float gridStartY, float cellSize,
+                float devicePixelRatio, float timeMs);
+
+    /**
+     * @brief 是否还有未结束的粒子（需要继续逐帧重绘）
+     */
+    bool hasLiveParticles(float timeMs) const;
+
+    /**
+     * @brief 清除所有发射器
+     */
+    void clear();
+
+    static constexpr int PARTICLES_PER_EMITTER = 64;     ///< 每个发射器的粒子上限
+    static constexpr float MAX_LIFETIME_MS = 900.0f;     ///< 粒子最长寿命（含发射延迟）
+
+private:
+    /**
+     * @brief 发射器类型（与着色器中的常量一致）
+     */
+    enum EmitterKind {
+        EMITTER_CELL = 0,       ///< 单个格子的小爆发
+        EMITTER_LINE_H,         ///< 横排炸弹：整行向上下喷射
+        EMITTER_LINE_V,         ///< 竖排炸弹：整列向左右喷射
+        EMITTER_DIAMOND,        ///< 菱形炸弹：向外扩散的光环
+        EMITTER_RAINBOW         ///< 彩虹：全盘彩色闪光
+    };
+
+    /**
+     * @brief 发射器（实例缓冲中的一项）
+     */
+    struct Emitter {
+        float col;              ///< 发射中心列
+        float row;              ///< 发射中心行
+        float kind;             ///< EmitterKind
+        float range;            ///< 菱形范围（格）；横竖排与彩虹为地图大小
+        float r, g, b;          ///< 粒子颜色（彩虹发射器忽略）
+        float startTime;        ///< 生成时间（相对 epochMs_，毫秒）
+    };
+
+    void addEmitter(float col, float row, EmitterKind kind, float range,
+                    float r, float g, float b, float startTime);
+
+    QOpenGLShaderProgram program_;
+    QOpenGLVertexArrayObject vao_;
+    QOpenGLBuffer emitterBuffer_;
+
+    std::vector<Emitter> emitters_;     ///< 存活的发射器
+    bool emittersDirty_ = false;        ///< 发射器列表变化后需要重新上传
+    float epochMs_ = 0.0f;              ///< 发射器时间基准（列表清空后重置，避免浮点精度下降）
+    float latestStartMs_ = 0.0f;        ///< 最近一个发射器的生成时间（相对 epochMs_）
+    bool initialized_ = false;
+};
+
+#endif // PARTICLERENDERER_H
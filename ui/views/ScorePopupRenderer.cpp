@@ -0,0 +1,456 @@
+#include "ScorePopupRenderer.h"
+#include <QOpenGLTexture>
+#include <QMatrix4x4>
+#include <QImage>
+#include <QPainter>
+#include <QPainterPath>
+#include <QFont>
+#include <QFontMetrics>
+#include <QDebug>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+const char* const POPUP_VERTEX_SHADER = R"(
+    #version 330 core
+    layout(location = 0) in vec2 a_corner;      // 单位四边形顶点 (0..1)
+    layout(location = 1) in vec4 a_rect;        // x, y, 宽, 高（像素）
+    layout(location = 2) in vec4 a_uv;          // u0, v0, u1, v1
+    layout(location = 3) in vec4 a_color;
+    layout(location = 4) in float a_outlined;
+
+    uniform mat4 u_projection;
+
+    out vec2 v_uv;
+    out vec4 v_color;
+    flat out float v_outlined;
+
+    void main()
+    {
+        gl_Position = u_projection * vec4(a_rect.xy + a_corner * a_rect.zw, 0.0, 1.0);
+        v_uv = mix(a_uv.xy, a_uv.zw, a_corner);
+        v_color = a_color;
+        v_outlined = a_outlined;
+    }
+)";
+
+// 图集通道：R 填充 / G 描边 / B 阴影；文字叠在描边或阴影之上
+const char* const POPUP_FRAGMENT_SHADER = R"(
+    #version 330 core
+    in vec2 v_uv;
+    in vec4 v_color;
+    flat in float v_outlined;
+
+    uniform sampler2D u_glyphs;
+
+    out vec4 fragColor;
+
+    void main()
+    {
+        vec3 mask = texture(u_glyphs, v_uv).rgb;
+        float backAlpha = v_outlined > 0.5 ? mask.g * (200.0 / 255.0) : mask.b * (150.0 / 255.0);
+        float alpha = mask.r + backAlpha * (1.0 - mask.r);
+        if (alpha <= 0.0) {
+            discard;
+        }
+        vec3 rgb = v_color.rgb * mask.r / alpha;    // 背景（描边/阴影）为黑色
+        fragColor = vec4(rgb, alpha * v_color.a);
+    }
+)";
+
+const char* const GLYPH_CHARS = "+0123456789";
+const int GLYPH_BASE_PIXELS = 64;       // 图集字号（像素）
+const int GLYPH_PADDING = 8;            // 字形格子四周留白（容纳描边与阴影）
+const float OUTLINE_WIDTH = 3.0f;       // 描边宽度（图集像素）
+const float SHADOW_OFFSET = 5.0f;       // 阴影偏移（图集像素）
+
+/**
+ * @brief 在透明图像上填充路径，返回覆盖率（alpha）图
+ */
+QImage rasterizePath(const QPainterPath& path, int width, int height)
+{
+    QImage image(width, height, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    QPainter painter(&image);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.fillPath(path, QColor(255, 255, 255));
+    painter.end();
+    return image;
+}
+
+} // namespace
+
+ScorePopupRenderer::ScorePopupRenderer()
+    : quadBuffer_(QOpenGLBuffer::VertexBuffer)
+    , instanceBuffer_(QOpenGLBuffer::VertexBuffer)
+{
+    popups_.reserve(MAX_POPUPS);
+}
+
+ScorePopupRenderer::~ScorePopupRenderer()
+{
+    // GPU 资源须由持有者在上下文有效时调用 cleanup() 释放
+}
+
+/**
+ * @brief 初始化 GPU 资源
+ */
+bool ScorePopupRenderer::initialize()
+{
+    initializeOpenGLFunctions();
+
+    // 1. 着色器
+    if (!program_.addShaderFromSourceCode(QOpenGLShader::Vertex, POPUP_VERTEX_SHADER)
+        || !program_.addShaderFromSourceCode(QOpenGLShader::Fragment, POPUP_FRAGMENT_SHADER)
+        || !program_.link()) {
+        qCritical() << "Failed to build score popup shader:" << program_.log();
+        return false;
+    }
+    program_.bind();
+    program_.setUniformValue("u_glyphs", 0);
+    program_.release();
+
+    // 2. 单位四边形 + 每实例属性
+    const float corners[] = {
+        0.0f, 0.0f,
+        1.0f, 0.0f,
+        0.0f, 1.0f,
+        1.0f, 1.0f
+    };
+
+    vao_.create();
+    vao_.bind();
+
+    quadBuffer_.create();
+    quadBuffer_.bind();
+    quadBuffer_.allocate(corners, sizeof(corners));
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), nullptr);
+
+    instanceBuffer_.create();
+    instanceBuffer_.setUsagePattern(QOpenGLBuffer::StreamDraw);
+    instanceBuffer_.bind();
+    const GLsizei stride = sizeof(GlyphInstance);
+    for (GLuint attribute = 1; attribute <= 4; ++attribute) {
+        glEnableVertexAttribArray(attribute);
+        glVertexAttribDivisor(attribute, 1);
+    }
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, stride, nullptr);
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<const void*>(4 * sizeof(float)));
+    glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<const void*>(8 * sizeof(float)));
+    glVertexAttribPointer(4, 1, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<const void*>(12 * sizeof(float)));
+
+    vao_.release();
+    instanceBuffer_.release();
+
+    // 3. 字形图集
+    if (!buildGlyphAtlas()) {
+        return false;
+    }
+
+    initialized_ = true;
+    qDebug() << "ScorePopupRenderer initialized";
+    return true;
+}
+
+/**
+ * @brief 光栅化 "+0123456789"，描边与阴影烘焙到独立通道
+ */
+bool ScorePopupRenderer::buildGlyphAtlas()
+{
+    QFont font("Microsoft YaHei");
+    font.setPixelSize(GLYPH_BASE_PIXELS);
+    font.setBold(true);
+    QFontMetrics metrics(font);
+
+    // 1. 字形格子排成一行
+    const int glyphCount = static_cast<int>(strlen(GLYPH_CHARS));
+    const int cellHeight = metrics.ascent() + metrics.descent() + GLYPH_PADDING * 2;
+    std::vector<int> cellWidths;
+    int atlasWidth = 0;
+    for (int i = 0; i < glyphCount; ++i) {
+        const int width = metrics.horizontalAdvance(QString(QChar(GLYPH_CHARS[i]))) + GLYPH_PADDING * 2;
+        cellWidths.push_back(width);
+        atlasWidth += width;
+    }
+    if (atlasWidth <= 0 || cellHeight <= 0) {
+        qCritical() << "Failed to measure score glyphs";
+        return false;
+    }
+
+    QImage atlas(atlasWidth, cellHeight, QImage::Format_ARGB32);
+    atlas.fill(Qt::black);
+
+    QPainterPathStroker stroker;
+    stroker.setWidth(OUTLINE_WIDTH * 2.0f);
+    stroker.setJoinStyle(Qt::RoundJoin);
+
+    // 2. 每个字形渲染三遍：填充、描边（外扩）、阴影（平移），分别写入 R/G/B
+    glyphs_.clear();
+    int x = 0;
+    for (int i = 0; i < glyphCount; ++i) {
+        const int width = cellWidths[i];
+        QPainterPath path;
+        path.addText(GLYPH_PADDING, GLYPH_PADDING + metrics.ascent(), font, QString(QChar(GLYPH_CHARS[i])));
+
+        const QImage fill = rasterizePath(path, width, cellHeight);
+        const QImage outline = rasterizePath(stroker.createStroke(path).united(path), width, cellHeight);
+        const QImage shadow = rasterizePath(path.translated(SHADOW_OFFSET, SHADOW_OFFSET), width, cellHeight);
+
+        for (int py = 0; py < cellHeight; ++py) {
+            for (int px = 0; px < width; ++px) {
+                atlas.setPixel(x + px, py, qRgba(qAlpha(fill.pixel(px, py)),
+                                                 qAlpha(outline.pixel(px, py)),
+                                                 qAlpha(shadow.pixel(px, py)), 255));
+            }
+        }
+
+        Glyph glyph;
+        glyph.uv = QRectF(static_cast<double>(x) / atlasWidth, 0.0,
+                          static_cast<double>(width) / atlasWidth, 1.0);
+        glyph.advance = metrics.horizontalAdvance(QString(QChar(GLYPH_CHARS[i])));
+        glyph.width = width;
+        glyphs_.push_back(glyph);
+        x += width;
+    }
+    glyphCellHeight_ = cellHeight;
+    glyphBaseline_ = GLYPH_PADDING + metrics.ascent();
+
+    // 3. 上传（缩小显示为主，使用 mipmap）
+    glyphTexture_ = new QOpenGLTexture(QOpenGLTexture::Target2D);
+    glyphTexture_->setData(atlas.convertToFormat(QImage::Format_RGBA8888));
+    glyphTexture_->setMinificationFilter(QOpenGLTexture::LinearMipMapLinear);
+    glyphTexture_->setMagnificationFilter(QOpenGLTexture::Linear);
+    glyphTexture_->setWrapMode(QOpenGLTexture::ClampToEdge);
+
+    qDebug() << "Score glyph atlas ready:" << atlasWidth << "x" << cellHeight;
+    return true;
+}
+
+void ScorePopupRenderer::cleanup()
+{
+    delete glyphTexture_;
+    glyphTexture_ = nullptr;
+
+    if (initialized_) {
+        vao_.destroy();
+        quadBuffer_.destroy();
+        instanceBuffer_.destroy();
+        program_.removeAllShaders();
+        initialized_ = false;
+    }
+}
+
+void ScorePopupRenderer::addScore(int score, int combo)
+{
+    if (score <= 0) return;
+
+    pendingScores_.push({score, combo});
+
+    // 队列空闲时立即显示，之后按间隔出队
+    if (queueCooldownMs_ <= 0.0f) {
+        showNextPending();
+        queueCooldownMs_ = QUEUE_INTERVAL_MS;
+    }
+}
+
+/**
+ * @brief 从队列中取出一个分数并显示
+ */
+void ScorePopupRenderer::showNextPending()
+{
+    if (pendingScores_.empty()) return;
+
+    PendingScore ps = pendingScores_.front();
+    pendingScores_.pop();
+
+    // 查找空闲槽位，已满时覆盖进度最大的
+    int slot = -1;
+    for (size_t i = 0; i < popups_.size(); ++i) {
+        if (!popups_[i].active) {
+            slot = static_cast<int>(i);
+            break;
+        }
+    }
+
+    if (slot < 0) {
+        if (popups_.size() < MAX_POPUPS) {
+            popups_.push_back(Popup());
+            slot = static_cast<int>(popups_.size() - 1);
+        } else {
+            float maxProgress = -1.0f;
+            for (size_t i = 0; i < popups_.size(); ++i) {
+                if (popups_[i].progress > maxProgress) {
+                    maxProgress = popups_[i].progress;
+                    slot = static_cast<int>(i);
+                }
+            }
+        }
+    }
+
+    popups_[slot].score = ps.score;
+    popups_[slot].combo = ps.combo;
+    popups_[slot].progress = 0.0f;
+    popups_[slot].active = true;
+}
+
+void ScorePopupRenderer::advance(float deltaMs)
+{
+    // 1. 队列按间隔出队
+    queueCooldownMs_ -= deltaMs;
+    while (queueCooldownMs_ <= 0.0f && !pendingScores_.empty()) {
+        showNextPending();
+        queueCooldownMs_ += QUEUE_INTERVAL_MS;
+    }
+    if (pendingScores_.empty()) {
+        queueCooldownMs_ = std::max(queueCooldownMs_, 0.0f);
+    }
+
+    // 2. 推进显示中的分数
+    const float deltaProgress = deltaMs / ANIMATION_DURATION_MS;
+    for (auto& popup : popups_) {
+        if (popup.active) {
+            popup.progress += deltaProgress;
+            if (popup.progress >= 1.0f) {
+                popup.active = false;
+            }
+        }
+    }
+}
+
+bool ScorePopupRenderer::isAnimating() const
+{
+    if (!pendingScores_.empty()) return true;
+    for (const auto& popup : popups_) {
+        if (popup.active) return true;
+    }
+    return false;
+}
+
+void ScorePopupRenderer::clear()
+{
+    for (auto& popup : popups_) {
+        popup.active = false;
+    }
+    while (!pendingScores_.empty()) {
+        pendingScores_.pop();
+    }
+    queueCooldownMs_ = 0.0f;
+}
+
+/**
+ * @brief 组装所有分数的字形实例，一次绘制
+ */
+void ScorePopupRenderer::render(int viewportWidth, int viewportHeight)
+{
+    if (!initialized_ || !glyphTexture_) {
+        return;
+    }
+
+    instances_.clear();
+    for (const auto& popup : popups_) {
+        if (!popup.active) continue;
+
+        // 上浮；后半段淡出；前 20% 从 1.3 倍缩回
+        float offsetY = -FLOAT_DISTANCE * popup.progress;
+        float alpha = 1.0f;
+        if (popup.progress > 0.5f) {
+            alpha = 1.0f - (popup.progress - 0.5f) * 2.0f;
+        }
+        alpha = std::max(0.0f, std::min(1.0f, alpha));
+
+        float scale = 1.0f;
+        if (popup.progress < 0.2f) {
+            scale = 1.0f + 0.3f * (1.0f - popup.progress / 0.2f);
+        }
+
+        // 字号为磅值，按 96 DPI 换算成像素后相对图集缩放
+        const float pixelSize = fontSize(popup.score, popup.combo) * scale * 4.0f / 3.0f;
+        const float glyphScale = pixelSize / GLYPH_BASE_PIXELS;
+
+        const QByteArray text = "+" + QByteArray::number(popup.score);
+        float textWidth = 0.0f;
+        for (char c : text) {
+            textWidth += glyphs_[glyphIndex(c)].advance * glyphScale;
+        }
+
+        const QVector4D color = scoreColor(popup.score, popup.combo);
+        const float outlined = (popup.score >= 100 || popup.combo >= 2) ? 1.0f : 0.0f;
+        const float baselineY = SPAWN_Y + offsetY;
+        float penX = viewportWidth / 2.0f - textWidth / 2.0f;
+
+        for (char c : text) {
+            const Glyph& glyph = glyphs_[glyphIndex(c)];
+            instances_.push_back({
+                penX - GLYPH_PADDING * glyphScale,
+                baselineY - glyphBaseline_ * glyphScale,
+                glyph.width * glyphScale,
+                glyphCellHeight_ * glyphScale,
+                static_cast<float>(glyph.uv.left()), static_cast<float>(glyph.uv.top()),
+                static_cast<float>(glyph.uv.right()), static_cast<float>(glyph.uv.bottom()),
+                color.x(), color.y(), color.z(), alpha,
+                outlined
+            });
+            penX += glyph.advance * glyphScale;
+        }
+    }
+
+    if (instances_.empty()) {
+        return;
+    }
+
+    QMatrix4x4 projection;
+    projection.ortho(0.0f, viewportWidth, viewportHeight, 0.0f, -1.0f, 1.0f);
+
+    program_.bind();
+    program_.setUniformValue("u_projection", projection);
+    glyphTexture_->bind(0);
+
+    vao_.bind();
+    instanceBuffer_.bind();
+    instanceBuffer_.allocate(instances_.data(), static_cast<int>(instances_.size() * sizeof(GlyphInstance)));
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(instances_.size()));
+    instanceBuffer_.release();
+    vao_.release();
+
+    program_.release();
+}
+
+int ScorePopupRenderer::glyphIndex(char c) const
+{
+    const char* found = strchr(GLYPH_CHARS, c);
+    return found ? static_cast<int>(found - GLYPH_CHARS) : 0;
+}
+
+QVector4D ScorePopupRenderer::scoreColor(int score, int combo)
+{
+    if (combo >= 5 || score >= 1000) {
+        return QVector4D(200 / 255.0f, 100 / 255.0f, 1.0f, 1.0f);    // 紫色
+    } else if (combo >= 4 || score >= 500) {
+        return QVector4D(1.0f, 80 / 255.0f, 80 / 255.0f, 1.0f);      // 红色
+    } else if (combo >= 3 || score >= 300) {
+        return QVector4D(1.0f, 165 / 255.0f, 0.0f, 1.0f);            // 橙色
+    } else if (combo >= 2 || score >= 150) {
+        return QVector4D(1.0f, 215 / 255.0f, 0.0f, 1.0f);            // 金黄
+    } else if (score >= 80) {
+        return QVector4D(1.0f, 1.0f, 100 / 255.0f, 1.0f);            // 浅黄
+    } else {
+        return QVector4D(1.0f, 1.0f, 1.0f, 1.0f);                    // 白色
+    }
+}
+
+int ScorePopupRenderer::fontSize(int score, int combo)
+{
+    int baseSize = 18;
+
+    if (score >= 500 || combo >= 4) {
+        return baseSize + 10;
+    } else if (score >= 300 || combo >= 3) {
+        return baseSize + 6;
+    } else if (score >= 150 || combo >= 2) {
+        return baseSize + 3;
+    } else {
+        return baseSize;
+    }
+}
@@ -0,0 +1,140 @@
+#ifndef SCOREPOPUPRENDERER_H
+#define SCOREPOPUPRENDERER_H
+
+#include <QOpenGLExtraFunctions>
+#include <QOpenGLShaderProgram>
+#include <QOpenGLBuffer>
+#include <QOpenGLVertexArrayObject>
+#include <QVector4D>
+#include <QRectF>
+#include <vector>
+#include <queue>
+
+class QOpenGLTexture;
+
+/**
+ * @brief 浮动分数弹出文字（在 GameView 的 OpenGL 绘制中完成）
+ *
+ * 职责：
+ * - 分数队列：每 QUEUE_INTERVAL_MS 显示一个，固定在视图上方居中生成，上浮并淡出
+ * - 启动时把 "+0123456789" 光栅化为一张字形图集，描边与阴影预先烘焙进图集通道
+ *   （R 填充 / G 描边 / B 阴影），每帧不再逐字重绘描边
+ * - 所有分数的所有字形合并为一次实例化绘制
+ *
+ * 动画由 GameView 的帧时钟驱动（advance），不使用定时器。
+ * initialize / cleanup / render 必须在 OpenGL 上下文中调用。
+ */
+class ScorePopupRenderer : protected QOpenGLExtraFunctions
+{
+public:
+    ScorePopupRenderer();
+    ~ScorePopupRenderer();
+
+    /**
+     * @brief 编译着色器、创建缓冲并生成字形图集
+     * @return 是否成功
+     */
+    bool initialize();
+
+    /**
+     * @brief 释放 GPU 资源（上下文销毁前调用）
+     */
+    void cleanup();
+
+    /**
+     * @brief 添加一个浮动分数到队列
+     * @param score 分数值
+     * @param combo 连击数
+     */
+    void addScore(int score, int combo);
+
+    /**
+     * @brief 推进队列与所有浮动分数的动画
+     * @param deltaMs 距上一帧经过的时间（毫秒）
+     */
+    void advance(float deltaMs);
+
+    /**
+     * @brief 是否有排队或正在显示的分数（需要继续逐帧重绘）
+     */
+    bool isAnimating() const;
+
+    /**
+     * @brief 清除所有浮动分数
+     */
+    void clear();
+
+    /**
+     * @brief 绘制所有正在显示的分数（一次绘制）
+     */
+    void render(int viewportWidth, int viewportHeight);
+
+private:
+    /**
+     * @brief 单个浮动分数
+     */
+    struct Popup {
+        int score = 0;          ///< 分数值
+        int combo = 0;          ///< 连击数
+        float progress = 0.0f;  ///< 动画进度 [0, 1]
+        bool active = false;    ///< 是否激活
+    };
+
+    /**
+     * @brief 待显示分数队列项
+     */
+    struct PendingScore {
+        int score;
+        int combo;
+    };
+
+    /**
+     * @brief 图集中的一个字形（尺寸为图集像素）
+     */
+    struct Glyph {
+        QRectF uv;              ///< 字形格子的 UV（含边距）
+        float advance = 0.0f;   ///< 步进宽度
+        float width = 0.0f;     ///< 格子宽度（含边距）
+    };
+
+    /**
+     * @brief 字形实例（实例缓冲中的一项）
+     */
+    struct GlyphInstance {
+        float x, y, width, height;  ///< 屏幕矩形
+        float u0, v0, u1, v1;       ///< 图集 UV
+        float r, g, b, a;           ///< 文字颜色与整体透明度
+        float outlined;             ///< 1 描边 / 0 阴影
+    };
+
+    bool buildGlyphAtlas();
+    void showNextPending();
+    int glyphIndex(char c) const;
+
+    static QVector4D scoreColor(int score, int combo);
+    static int fontSize(int score, int combo);
+
+    QOpenGLShaderProgram program_;
+    QOpenGLVertexArrayObject vao_;
+    QOpenGLBuffer quadBuffer_;                  ///< 单位四边形
+    QOpenGLBuffer instanceBuffer_;              ///< 字形实例（每帧重写）
+    QOpenGLTexture* glyphTexture_ = nullptr;    ///< 字形图集
+
+    std::vector<Glyph> glyphs_;                 ///< 与 GLYPH_CHARS 顺序一致
+    float glyphCellHeight_ = 0.0f;              ///< 字形格子高度（含边距，图集像素）
+    float glyphBaseline_ = 0.0f;                ///< 格子顶部到基线的距离（图集像素）
+
+    std::vector<Popup> popups_;
+    std::queue<PendingScore> pendingScores_;    ///< 待显示的分数队列
+    float queueCooldownMs_ = 0.0f;              ///< 距离下一个分数出队的时间
+    std::vector<GlyphInstance> instances_;      ///< 本帧的字形实例
+    bool initialized_ = false;
+
+    static const int MAX_POPUPS = 20;
+    static constexpr float ANIMATION_DURATION_MS = 1500.0f; ///< 单个分数的显示时长
+    static constexpr float QUEUE_INTERVAL_MS = 200.0f;      ///< 队列间隔
+    static constexpr float FLOAT_DISTANCE = 80.0f;          ///< 上浮距离（像素）
+    static constexpr float SPAWN_Y = 150.0f;                ///< 生成位置（基线距视图顶部，像素）
+};
+
+#endif // SCOREPOPUPRENDERER_H
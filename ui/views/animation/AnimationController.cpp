@@ -53,7 +53,7 @@ void AnimationController::beginShuffle()
     phaseCompleted_ = false;
 }
 
-bool AnimationController::updateProgress()
+bool AnimationController::updateProgress(float deltaMs)
 {
     if (currentPhase_ == AnimPhase::IDLE) {
         return false;
@@ -71,11 +71,13 @@ bool AnimationController::updateProgress()
         return true;  // 阶段完成
     }
     
-    const float frameTime = 16.0f;  // ~60 FPS
-    const float duration = getCurrentPhaseDuration();
-    const float delta = frameTime / duration;
+    // 回调已触发但尚未进入下一阶段（如轮次间的停顿），保持最后一帧，不重复回调
+    if (progress_ >= 1.0f) {
+        return false;
+    }
     
-    progress_ += delta;
+    const float duration = getCurrentPhaseDuration();
+    progress_ += deltaMs / duration;
     
     if (progress_ >= 1.0f) {
         progress_ = 1.0f;
@@ -20,7 +20,7 @@ enum class AnimPhase {
  * 
  * 职责：
  * - 管理动画阶段流转（IDLE → SWAPPING → ELIMINATING → FALLING → ...）
- * - 管理动画进度更新
+ * - 管理动画进度更新（按真实经过时间推进，掉帧时时长不变）
  * - 协调各个动画渲染器的启动和停止
  */
 class AnimationController
@@ -59,9 +59,10 @@ public:
     
     /**
      * @brief 更新动画进度（每帧调用）
+     * @param deltaMs 距上一帧经过的时间（毫秒）
      * @return 当前阶段是否完成
      */
-    bool updateProgress();
+    bool updateProgress(float deltaMs);
     
     /**
      * @brief 获取当前动画阶段
@@ -3,14 +3,15 @@
 
 #include "IAnimationRenderer.h"
 
-class QOpenGLTexture;
+class BoardRenderer;
 
 /**
  * @brief 消除动画渲染器
  * 
  * 职责：
  * - 绘制消除动画（水果缩小消失）
- * - 绘制炸弹特效（横排、竖排、菱形、彩虹）
+ *
+ * 炸弹特效与消除粒子由 ParticleRenderer 在 GPU 上绘制。
  */
 class EliminationAnimationRenderer : public IAnimationRenderer
 {
@@ -28,7 +29,7 @@ public:
         float gridStartY,
         float cellSize,
         int mapSize,
-        const std::vector<QOpenGLTexture*>& textures
+        BoardRenderer& board
     ) override;
     
 private:
@@ -41,17 +42,7 @@ private:
         const std::vector<std::vector<Fruit>>& snapshot,
         float gridStartX, float gridStartY, float cellSize,
         int mapSize,
-        const std::vector<QOpenGLTexture*>& textures
-    );
-    
-    /**
-     * @brief 绘制炸弹特效
-     */
-    void renderBombEffects(
-        const EliminationStep& step,
-        float progress,
-        float gridStartX, float gridStartY, float cellSize,
-        int mapSize
+        BoardRenderer& board
     );
 };
 
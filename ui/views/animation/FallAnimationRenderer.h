@@ -3,7 +3,7 @@
 
 #include "IAnimationRenderer.h"
 
-class QOpenGLTexture;
+class BoardRenderer;
 
 /**
  * @brief 下落动画渲染器
@@ -16,6 +16,7 @@ class QOpenGLTexture;
  * - 使用 round.fall.moves 精确控制每个水果的移动
  * - 使用 round.fall.newFruits 精确控制新水果的生成
  * - 不依赖engineMap（最终状态），确保多轮消除时动画正确
+ * - 运动数据在阶段开始时上传一次，每帧只更新进度，CPU 开销与下落数量无关
  */
 class FallAnimationRenderer : public IAnimationRenderer
 {
@@ -24,7 +25,18 @@ public:
     ~FallAnimationRenderer() override;
     
     /**
-     * @brief 实现基类接口：渲染下落动画
+     * @brief 阶段开始时把下落运动一次性交给 BoardRenderer
+     */
+    void prepare(
+        const GameAnimationSequence& animSeq,
+        int roundIndex,
+        const std::vector<std::vector<Fruit>>& snapshot,
+        int mapSize,
+        BoardRenderer& board
+    ) override;
+    
+    /**
+     * @brief 实现基类接口：渲染下落动画（只提交进度，插值在着色器中完成）
      */
     void render(
         const GameAnimationSequence& animSeq,
@@ -36,7 +48,7 @@ public:
         float gridStartY,
         float cellSize,
         int mapSize,
-        const std::vector<QOpenGLTexture*>& textures
+        BoardRenderer& board
     ) override;
 };
 
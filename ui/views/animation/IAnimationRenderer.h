@@ -1,35 +1,47 @@
 #ifndef IANIMATIONRENDERER_H
 #define IANIMATIONRENDERER_H
 
-#include <QOpenGLFunctions>
 #include <vector>
 #include "FruitTypes.h"
 #include "GameEngine.h"
 
-class QOpenGLTexture;
+class BoardRenderer;
 
 /**
  * @brief 动画渲染器接口（抽象基类）
  * 
  * 定义所有动画渲染器的统一接口，遵循策略模式
- * 继承QOpenGLFunctions以直接调用OpenGL函数
+ * 渲染器不直接调用OpenGL，而是把精灵/矩形提交到 BoardRenderer 批量绘制
  * 
  * 设计原则：
  * - 单一职责：每个渲染器只负责一种动画效果
  * - 开闭原则：对扩展开放，对修改封闭
  * - 依赖倒置：GameView依赖抽象接口，不依赖具体实现
  */
-class IAnimationRenderer : protected QOpenGLFunctions
+class IAnimationRenderer
 {
 public:
     virtual ~IAnimationRenderer() = default;
     
     /**
-     * @brief 初始化OpenGL函数（必须在OpenGL上下文中调用）
+     * @brief 阶段开始时准备动画数据（默认无操作）
+     * 
+     * 可在此把整个阶段的逐实例运动数据一次性交给 BoardRenderer，
+     * 之后每帧的 render 只需提交进度。不要求 OpenGL 上下文。
+     * 
+     * @param animSeq 动画序列
+     * @param roundIndex 当前轮次索引
+     * @param snapshot 快照地图（阶段开始时的状态）
+     * @param mapSize 地图大小
+     * @param board 批量渲染器
      */
-    void initialize() {
-        initializeOpenGLFunctions();
-    }
+    virtual void prepare(
+        const GameAnimationSequence& /*animSeq*/,
+        int /*roundIndex*/,
+        const std::vector<std::vector<Fruit>>& /*snapshot*/,
+        int /*mapSize*/,
+        BoardRenderer& /*board*/
+    ) {}
     
     /**
      * @brief 渲染动画（纯虚函数）
@@ -43,7 +55,7 @@ public:
      * @param gridStartY 网格起始Y坐标
      * @param cellSize 格子大小
      * @param mapSize 地图大小
-     * @param textures 纹理数组
+     * @param board 批量渲染器（提交绘制内容）
      */
     virtual void render(
         const GameAnimationSequence& animSeq,
@@ -55,29 +67,8 @@ public:
         float gridStartY,
         float cellSize,
         int mapSize,
-        const std::vector<QOpenGLTexture*>& textures
+        BoardRenderer& board
     ) = 0;
-    
-protected:
-    /**
-     * @brief 绘制单个水果的辅助函数（供子类使用）
-     */
-    void drawFruit(
-        int row, int col,
-        const Fruit& fruit,
-        float offsetX, float offsetY,
-        float alpha,
-        float scale,
-        float gridStartX, float gridStartY, float cellSize,
-        const std::vector<QOpenGLTexture*>& textures
-    );
-    
-    /**
-     * @brief 绘制四边形的辅助函数
-     */
-    void drawQuad(
-        float x, float y, float width, float height
-    );
 };
 
 #endif // IANIMATIONRENDERER_H
@@ -1,5 +1,5 @@
 #include "ShuffleAnimationRenderer.h"
-#include <QOpenGLTexture>
+#include "BoardRenderer.h"
 
 ShuffleAnimationRenderer::ShuffleAnimationRenderer()
 {
@@ -19,26 +19,23 @@ void ShuffleAnimationRenderer::render(
     float gridStartY,
     float cellSize,
     int mapSize,
-    const std::vector<QOpenGLTexture*>& textures)
+    BoardRenderer& board)
 {
     if (!animSeq.shuffled || animSeq.newMapAfterShuffle.empty()) {
         return;
     }
     
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    
     // 第一阶段(0-0.5): 旧元素淡出并缩小
     // 第二阶段(0.5-1.0): 新元素淡入并放大
     
     if (progress < 0.5f) {
         // 第一阶段：绘制快照中的旧元素（淡出）
         float phase = progress / 0.5f;  // 0 ?1
-        renderFadeOut(phase, snapshot, gridStartX, gridStartY, cellSize, mapSize, textures);
+        renderFadeOut(phase, snapshot, gridStartX, gridStartY, cellSize, mapSize, board);
     } else {
         // 第二阶段：绘制新地图中的元素（淡入）
         float phase = (progress - 0.5f) / 0.5f;  // 0 ?1
-        renderFadeIn(phase, animSeq.newMapAfterShuffle, gridStartX, gridStartY, cellSize, mapSize, textures);
+        renderFadeIn(phase, animSeq.newMapAfterShuffle, gridStartX, gridStartY, cellSize, mapSize, board);
     }
 }
 
@@ -47,7 +44,7 @@ void ShuffleAnimationRenderer::renderFadeOut(
     const std::vector<std::vector<Fruit>>& snapshot,
     float gridStartX, float gridStartY, float cellSize,
     int mapSize,
-    const std::vector<QOpenGLTexture*>& textures)
+    BoardRenderer& board)
 {
     float alpha = 1.0f - phase;
     float scale = 1.0f - phase * 0.3f;
@@ -59,8 +56,7 @@ void ShuffleAnimationRenderer::renderFadeOut(
                 continue;
             }
             
-            drawFruit(row, col, fruit, 0.0f, 0.0f, alpha, scale,
-                      gridStartX, gridStartY, cellSize, textures);
+            board.addFruit(row, col, fruit, 0.0f, 0.0f, alpha, scale);
         }
     }
 }
@@ -70,7 +66,7 @@ void ShuffleAnimationRenderer::renderFadeIn(
     const std::vector<std::vector<Fruit>>& newMap,
     float gridStartX, float gridStartY, float cellSize,
     int mapSize,
-    const std::vector<QOpenGLTexture*>& textures)
+    BoardRenderer& board)
 {
     float alpha = phase;
     float scale = 0.7f + phase * 0.3f;
@@ -82,8 +78,7 @@ void ShuffleAnimationRenderer::renderFadeIn(
                 continue;
             }
             
-            drawFruit(row, col, fruit, 0.0f, 0.0f, alpha, scale,
-                      gridStartX, gridStartY, cellSize, textures);
+            board.addFruit(row, col, fruit, 0.0f, 0.0f, alpha, scale);
         }
     }
 }
@@ -3,7 +3,7 @@
 
 #include "IAnimationRenderer.h"
 
-class QOpenGLTexture;
+class BoardRenderer;
 
 /**
  * @brief 重排动画渲染器
@@ -33,7 +33,7 @@ public:
         float gridStartY,
         float cellSize,
         int mapSize,
-        const std::vector<QOpenGLTexture*>& textures
+        BoardRenderer& board
     ) override;
     
 private:
@@ -45,7 +45,7 @@ private:
         const std::vector<std::vector<Fruit>>& snapshot,
         float gridStartX, float gridStartY, float cellSize,
         int mapSize,
-        const std::vector<QOpenGLTexture*>& textures
+        BoardRenderer& board
     );
     
     /**
@@ -56,7 +56,7 @@ private:
         const std::vector<std::vector<Fruit>>& newMap,
         float gridStartX, float gridStartY, float cellSize,
         int mapSize,
-        const std::vector<QOpenGLTexture*>& textures
+        BoardRenderer& board
     );
 };
 
@@ -2,7 +2,7 @@
 #define SNAPSHOTMANAGER_H
 
 #include <vector>
-#include <set>
+#include <cstdint>
 #include "FruitTypes.h"
 #include "AnimationController.h"
 #include "GameEngine.h"
@@ -15,6 +15,10 @@
  * - 根据消除消息更新快照
  * - 根据下落消息更新快照
  * - 管理隐藏格子集合
+ *
+ * 快照存储在整个游戏过程中复用：保存时逐行原地复制，清除时只标记无效，
+ * 各轮消除/下落只改写涉及的格子。隐藏格子用按 row * mapSize + col 索引的位图记录，
+ * drawFruitGrid 每帧逐格查询为 O(1)。
  */
 class SnapshotManager
 {
@@ -40,7 +44,7 @@ public:
     /**
      * @brief 快照是否为空
      */
-    bool isSnapshotEmpty() const { return snapshot_.empty(); }
+    bool isSnapshotEmpty() const { return !hasSnapshot_; }
     
     /**
      * @brief 应用交换到快照
@@ -79,9 +83,24 @@ public:
      */
     void hideAllCells();
     
+    /**
+     * @brief 修订号（快照或隐藏集合每次变化递增，用于判断静态层缓存是否过期）
+     */
+    unsigned int getRevision() const { return revision_; }
+    
 private:
-    std::vector<std::vector<Fruit>> snapshot_;       ///< 地图快照
-    std::set<std::pair<int, int>> hiddenCells_;      ///< 隐藏格子集合
+    bool isInside(int row, int col) const {
+        return row >= 0 && row < mapSize_ && col >= 0 && col < mapSize_;
+    }
+    void hideCell(int row, int col);
+    void clearCell(int row, int col);
+    
+    std::vector<std::vector<Fruit>> snapshot_;       ///< 地图快照（存储复用，不随 clearSnapshot 释放）
+    bool hasSnapshot_ = false;                       ///< 快照是否有效
+    int mapSize_ = 0;                                ///< 快照的地图大小
+    std::vector<std::uint64_t> hiddenBits_;          ///< 隐藏格子位图
+    bool hasHiddenCells_ = false;                    ///< 位图中是否有置位（避免重复清零）
+    unsigned int revision_ = 0;                      ///< 修订号
 };
 
 #endif // SNAPSHOTMANAGER_H
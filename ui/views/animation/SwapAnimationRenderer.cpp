@@ -1,5 +1,5 @@
 #include "SwapAnimationRenderer.h"
-#include <QOpenGLTexture>
+#include "BoardRenderer.h"
 
 SwapAnimationRenderer::SwapAnimationRenderer()
 {
@@ -9,54 +9,54 @@ SwapAnimationRenderer::~SwapAnimationRenderer()
 {
 }
 
-void SwapAnimationRenderer::render(
+void SwapAnimationRenderer::prepare(
     const GameAnimationSequence& animSeq,
-    int roundIndex,
-    float progress,
+    int /*roundIndex*/,
     const std::vector<std::vector<Fruit>>& snapshot,
-    const std::vector<std::vector<Fruit>>& engineMap,
-    float gridStartX,
-    float gridStartY,
-    float cellSize,
     int mapSize,
-    const std::vector<QOpenGLTexture*>& textures)
+    BoardRenderer& board)
 {
     // 从动画序列获取交换信息
     int row1 = animSeq.swap.row1;
     int col1 = animSeq.swap.col1;
     int row2 = animSeq.swap.row2;
     int col2 = animSeq.swap.col2;
-    bool success = animSeq.swap.success;
-    
-    if (row1 < 0 || col1 < 0 || row2 < 0 || col2 < 0) {
-        return;
-    }
-    
-    // 从快照获取交换前的水果
-    const Fruit& fruit1 = snapshot[row1][col1];
-    const Fruit& fruit2 = snapshot[row2][col2];
-    
-    float t = progress;
-    if (!success) {
-        // 回弹：前半程出去，后半程回来
-        t = (t <= 0.5f) ? (t * 2.0f) : ((1.0f - t) * 2.0f);
-    }
     
-    // 计算位移方向
-    int dirRow = row2 - row1;
-    int dirCol = col2 - col1;
-    float dx = dirCol * cellSize * t;
-    float dy = dirRow * cellSize * t;
+    std::vector<MotionInstance> motions;
     
-    // 绘制第一个水果（从位置1向位置2移动）
-    if (fruit1.type != FruitType::EMPTY) {
-        drawFruit(row1, col1, fruit1, dx, dy, 1.0f, 1.0f,
-                  gridStartX, gridStartY, cellSize, textures);
+    if (row1 >= 0 && col1 >= 0 && row2 >= 0 && col2 >= 0 &&
+        row1 < mapSize && col1 < mapSize && row2 < mapSize && col2 < mapSize &&
+        static_cast<int>(snapshot.size()) == mapSize) {
+        // 失败时回弹：前半程出去，后半程回来
+        const auto easing = animSeq.swap.success ? BoardRenderer::EASE_LINEAR : BoardRenderer::EASE_PING_PONG;
+        
+        // 从快照获取交换前的水果：第一个从位置1向位置2移动，第二个反向
+        MotionInstance motion;
+        if (BoardRenderer::makeMotion(snapshot[row1][col1], static_cast<float>(row1), static_cast<float>(col1),
+                                      row2, col2, easing, 0.0f, motion)) {
+            motions.push_back(motion);
+        }
+        if (BoardRenderer::makeMotion(snapshot[row2][col2], static_cast<float>(row2), static_cast<float>(col2),
+                                      row1, col1, easing, 0.0f, motion)) {
+            motions.push_back(motion);
+        }
     }
     
-    // 绘制第二个水果（从位置2向位置1移动）
-    if (fruit2.type != FruitType::EMPTY) {
-        drawFruit(row2, col2, fruit2, -dx, -dy, 1.0f, 1.0f,
-                  gridStartX, gridStartY, cellSize, textures);
-    }
+    board.setMotions(std::move(motions));
+}
+
+void SwapAnimationRenderer::render(
+    const GameAnimationSequence& /*animSeq*/,
+    int /*roundIndex*/,
+    float progress,
+    const std::vector<std::vector<Fruit>>& /*snapshot*/,
+    const std::vector<std::vector<Fruit>>& /*engineMap*/,
+    float /*gridStartX*/,
+    float /*gridStartY*/,
+    float /*cellSize*/,
+    int /*mapSize*/,
+    BoardRenderer& board)
+{
+    // 运动数据已在 prepare 中上传，位置由着色器按进度插值
+    board.drawMotions(progress);
 }
@@ -3,14 +3,14 @@
 
 #include "IAnimationRenderer.h"
 
-class QOpenGLTexture;
+class BoardRenderer;
 
 /**
  * @brief 交换动画渲染器
  * 
  * 职责：
  * - 绘制交换动画（两个水果的移动）
- * - 支持成功交换和失败回弹
+ * - 支持成功交换和失败回弹（EASE_PING_PONG，由着色器计算）
  * 
  * 继承关系：IAnimationRenderer → SwapAnimationRenderer
  */
@@ -21,7 +21,18 @@ public:
     ~SwapAnimationRenderer() override;
     
     /**
-     * @brief 实现基类接口：渲染交换动画
+     * @brief 阶段开始时把交换运动一次性交给 BoardRenderer
+     */
+    void prepare(
+        const GameAnimationSequence& animSeq,
+        int roundIndex,
+        const std::vector<std::vector<Fruit>>& snapshot,
+        int mapSize,
+        BoardRenderer& board
+    ) override;
+    
+    /**
+     * @brief 实现基类接口：渲染交换动画（只提交进度，插值在着色器中完成）
      */
     void render(
         const GameAnimationSequence& animSeq,
@@ -33,7 +44,7 @@ public:
         float gridStartY,
         float cellSize,
         int mapSize,
-        const std::vector<QOpenGLTexture*>& textures
+        BoardRenderer& board
     ) override;
     
 private: